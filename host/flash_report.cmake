@@ -0,0 +1,16 @@
+# Prints the .text difference between the stripped and kept
+# reachability benches (cmake -P, see CMakeLists.txt)
+function(text_size file out)
+    execute_process(COMMAND ${SIZE_TOOL} ${file} OUTPUT_VARIABLE table RESULT_VARIABLE err)
+    if(err)
+        message(FATAL_ERROR "${SIZE_TOOL} ${file} failed")
+    endif()
+    # Berkeley format: header line, then "text data bss dec hex file"
+    string(REGEX MATCH "\n[ \t]*([0-9]+)" _ "${table}")
+    set(${out} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+text_size(${STRIPPED} stripped)
+text_size(${KEPT} kept)
+math(EXPR saved "${kept} - ${stripped}")
+message(STATUS "FSM reachability: .text ${kept} -> ${stripped} bytes with fsm::strip_unreachable, ${saved} saved")
@@ -0,0 +1,65 @@
+// host_main.cpp
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "host_task.h"
+#include "sim_clock.hpp"
+
+//------------------------------------------------------------
+// Native entry point: runs app_main in a task named "main"
+//
+//   ./cpp_variant                  run until app_main returns (or ^C)
+//   ./cpp_variant --seconds 10     stop after 10 s wall time
+//   ./cpp_variant --sim-seconds N  stop after N s of virtual time
+//                                  (HOST_VIRTUAL_TIME builds only)
+//
+// The examples loop forever like they do on target, so the
+// time limit is how they are run from scripts and profilers.
+//------------------------------------------------------------
+extern "C" void app_main(void);
+
+namespace {
+
+constexpr UBaseType_t MAIN_TASK_PRIO = 1; // ESP_TASK_MAIN_PRIO
+
+[[noreturn]] void stop()
+{
+    // Detached tasks are still running: skip static destructors
+    std::fflush(stdout);
+    std::_Exit(EXIT_SUCCESS);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--seconds") == 0) {
+            const auto limit = std::chrono::seconds{ std::atol(argv[i + 1]) };
+            std::thread([limit] {
+                std::this_thread::sleep_for(limit);
+                stop();
+            }).detach();
+        }
+#if SIM_VIRTUAL_TIME
+        if (std::strcmp(argv[i], "--sim-seconds") == 0) {
+            const auto limit = std::chrono::seconds{ std::atol(argv[i + 1]) };
+            const auto wall_start = std::chrono::steady_clock::now();
+            sim::stop_at(limit, [limit, wall_start] {
+                const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+                std::printf("Simulated %lld s in %.3f s wall time\n", static_cast<long long>(limit.count()), wall.count());
+                stop();
+            });
+        }
+#endif
+    }
+
+    host_task_init("main", MAIN_TASK_PRIO);
+    app_main();
+    stop();
+}
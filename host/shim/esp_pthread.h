@@ -0,0 +1,27 @@
+// esp_pthread.h (host shim)
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+
+typedef struct {
+    size_t stack_size;       // recorded only, host threads keep the default stack
+    size_t prio;             // reported by uxTaskPriorityGet, not applied
+    bool inherit_cfg;        // threads created by the new thread reuse this cfg
+    const char* thread_name; // applied with pthread_setname_np
+    int pin_to_core;         // core % host CPUs, or tskNO_AFFINITY
+} esp_pthread_cfg_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_pthread_cfg_t esp_pthread_get_default_config(void);
+esp_err_t esp_pthread_set_cfg(const esp_pthread_cfg_t* cfg);
+esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t* cfg);
+
+#ifdef __cplusplus
+}
+#endif
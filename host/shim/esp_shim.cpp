@@ -0,0 +1,215 @@
+// esp_shim.cpp
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <esp_log.h>
+#include <esp_pthread.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "host_task.h"
+#include "sim_clock.hpp"
+
+//------------------------------------------------------------
+// FreeRTOS / esp_pthread / esp_log on top of Linux pthreads
+//
+// Each thread carries a small task record (name, priority,
+// configured stack) in thread-local storage. esp_pthread_set_cfg
+// stores the config for the next threads this thread creates;
+// pthread_create is interposed so that std::thread / jthread
+// pick it up exactly like on target: name, core pinning, and
+// inheritance when inherit_cfg is set. Priorities and stack
+// sizes are recorded for reporting only.
+//------------------------------------------------------------
+namespace {
+
+constexpr std::size_t NAME_LEN = 16; // configMAX_TASK_NAME_LEN
+
+struct Task {
+    char name[NAME_LEN] = "pthread";
+    UBaseType_t prio = 5;
+    std::size_t stack_size = 3072;
+    esp_pthread_cfg_t next_cfg = esp_pthread_get_default_config();
+    bool has_cfg = false;
+};
+
+thread_local Task self;
+
+const auto start_time = std::chrono::steady_clock::now();
+esp_log_level_t log_level = ESP_LOG_VERBOSE;
+
+void set_name(Task& task, const char* name)
+{
+    std::strncpy(task.name, name, NAME_LEN - 1);
+    task.name[NAME_LEN - 1] = '\0';
+    pthread_setname_np(pthread_self(), task.name);
+}
+
+struct Start {
+    void* (*fn)(void*);
+    void* arg;
+    esp_pthread_cfg_t cfg;
+};
+
+void* start_task(void* p)
+{
+    const Start start = *static_cast<Start*>(p);
+    delete static_cast<Start*>(p);
+
+    const esp_pthread_cfg_t& cfg = start.cfg;
+    set_name(self, cfg.thread_name ? cfg.thread_name : "pthread");
+    self.prio = static_cast<UBaseType_t>(cfg.prio);
+    self.stack_size = cfg.stack_size;
+    if (cfg.inherit_cfg) {
+        self.next_cfg = cfg;
+        self.has_cfg = true;
+    }
+    if (cfg.pin_to_core >= 0 && cfg.pin_to_core != tskNO_AFFINITY) {
+        const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<unsigned>(cfg.pin_to_core) % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+    }
+    return start.fn(start.arg);
+}
+
+} // namespace
+
+//------------------------------------------------------------
+// pthread_create interposer: applies the pending esp_pthread cfg
+//------------------------------------------------------------
+extern "C" int pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*fn)(void*), void* arg)
+{
+    using create_fn = int (*)(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*);
+    static const auto real_create = reinterpret_cast<create_fn>(dlsym(RTLD_NEXT, "pthread_create"));
+
+    if (!self.has_cfg) {
+        return real_create(thread, attr, fn, arg);
+    }
+    auto* start = new Start{ fn, arg, self.next_cfg };
+    const int err = real_create(thread, attr, start_task, start);
+    if (err != 0) {
+        delete start;
+    }
+    return err;
+}
+
+//------------------------------------------------------------
+// FreeRTOS
+//------------------------------------------------------------
+extern "C" BaseType_t xPortGetCoreID(void)
+{
+    const int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : cpu % portNUM_PROCESSORS;
+}
+
+extern "C" char* pcTaskGetName(TaskHandle_t)
+{
+    return self.name;
+}
+
+extern "C" UBaseType_t uxTaskPriorityGet(TaskHandle_t)
+{
+    return self.prio;
+}
+
+extern "C" UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return 0;
+    }
+    void* base = nullptr;
+    std::size_t size = 0;
+    pthread_attr_getstack(&attr, &base, &size);
+    pthread_attr_destroy(&attr);
+
+    const char marker = 0;
+    return static_cast<UBaseType_t>(&marker - static_cast<const char*>(base));
+}
+
+//------------------------------------------------------------
+// esp_pthread
+//------------------------------------------------------------
+extern "C" esp_pthread_cfg_t esp_pthread_get_default_config(void)
+{
+    return {
+        .stack_size = 3072,
+        .prio = 5,
+        .inherit_cfg = false,
+        .thread_name = nullptr,
+        .pin_to_core = tskNO_AFFINITY,
+    };
+}
+
+extern "C" esp_err_t esp_pthread_set_cfg(const esp_pthread_cfg_t* cfg)
+{
+    if (cfg == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    self.next_cfg = *cfg;
+    self.has_cfg = true;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t* cfg)
+{
+    if (!self.has_cfg) {
+        return ESP_FAIL;
+    }
+    *cfg = self.next_cfg;
+    return ESP_OK;
+}
+
+//------------------------------------------------------------
+// esp_log: one vfprintf per line keeps lines from interleaving
+//------------------------------------------------------------
+// Virtual milliseconds in HOST_VIRTUAL_TIME builds, so logs diff cleanly
+extern "C" uint32_t esp_log_timestamp(void)
+{
+#if SIM_VIRTUAL_TIME
+    const auto elapsed = sim::now().time_since_epoch();
+#else
+    const auto elapsed = std::chrono::steady_clock::now() - start_time;
+#endif
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+extern "C" void esp_log_level_set(const char*, esp_log_level_t level)
+{
+    log_level = level;
+}
+
+extern "C" esp_log_level_t esp_log_level_get(const char*)
+{
+    return log_level;
+}
+
+extern "C" void esp_log_write(esp_log_level_t level, const char*, const char* format, ...)
+{
+    if (level > log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    std::vfprintf(stdout, format, args);
+    va_end(args);
+}
+
+//------------------------------------------------------------
+// Host only
+//------------------------------------------------------------
+extern "C" void host_task_init(const char* name, UBaseType_t prio)
+{
+    set_name(self, name);
+    self.prio = prio;
+}
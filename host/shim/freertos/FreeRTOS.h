@@ -0,0 +1,22 @@
+// FreeRTOS.h (host shim)
+#pragma once
+
+#include <stdint.h>
+
+// Same widths as the Xtensa / RISC-V ports
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void* TaskHandle_t;
+
+#define portNUM_PROCESSORS 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host CPU the caller runs on, folded onto portNUM_PROCESSORS
+BaseType_t xPortGetCoreID(void);
+
+#ifdef __cplusplus
+}
+#endif
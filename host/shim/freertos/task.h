@@ -0,0 +1,22 @@
+// task.h (host shim)
+#pragma once
+
+#include "FreeRTOS.h"
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Only the calling task is supported: pass nullptr as the handle
+char* pcTaskGetName(TaskHandle_t task);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+
+// Bytes of stack still free right now (host stacks are not painted,
+// so this is the current headroom rather than the all-time minimum)
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+#ifdef __cplusplus
+}
+#endif
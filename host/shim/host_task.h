@@ -0,0 +1,15 @@
+// host_task.h (host shim)
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Names the calling thread as a task, e.g. "main" for app_main
+void host_task_init(const char* name, UBaseType_t prio);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,104 @@
+// alloc_count.cpp
+#include "alloc_count.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaceable allocation functions cannot be inline, so they live
+// here, once per program
+namespace alloc {
+namespace {
+
+void* allocate(std::size_t size) noexcept
+{
+    ++allocations;
+    allocated_bytes += size;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) noexcept
+{
+    ++allocations;
+    allocated_bytes += size;
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a non-zero multiple of the alignment
+    return std::aligned_alloc(align, size == 0 ? align : (size + align - 1) & ~(align - 1));
+}
+
+// aligned_alloc memory goes back through free(); out of line because
+// GCC flags free() inlined into an aligned delete (-Wmismatched-new-delete)
+[[gnu::noinline]] void release_aligned(void* p) noexcept
+{
+    std::free(p);
+}
+
+} // namespace
+} // namespace alloc
+
+void* operator new(std::size_t size)
+{
+    if (void* p = alloc::allocate(size)) {
+        return p;
+    }
+#if __cpp_exceptions
+    throw std::bad_alloc{};
+#else
+    std::abort(); // IDF default: -fno-exceptions
+#endif
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return alloc::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = alloc::allocate(size, alignment)) {
+        return p;
+    }
+#if __cpp_exceptions
+    throw std::bad_alloc{};
+#else
+    std::abort();
+#endif
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return alloc::allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return alloc::allocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alloc::release_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alloc::release_aligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alloc::release_aligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alloc::release_aligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloc::release_aligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alloc::release_aligned(p); }
@@ -0,0 +1,39 @@
+// alloc_count.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------
+// Per-task heap allocation counter
+//
+// alloc_count.cpp replaces the global operator new/delete with
+// malloc/free plus a thread_local count, so a task can check
+// that a code path does not touch the heap: take alloc::count()
+// before and after, or hold an alloc::Probe. Only operator new
+// is seen; direct malloc (newlib, lwIP, FreeRTOS) is not.
+// Over-aligned types (anything holding a cache-line aligned
+// SeqLock, say) use the std::align_val_t overloads, which are
+// replaced and counted too. Without alloc_count.cpp linked in
+// the counts stay at zero.
+//------------------------------------------------------------
+namespace alloc {
+
+inline thread_local std::uint32_t allocations = 0;
+inline thread_local std::size_t allocated_bytes = 0;
+
+[[nodiscard]] inline std::uint32_t count() { return allocations; }
+[[nodiscard]] inline std::size_t bytes() { return allocated_bytes; }
+
+// Allocations made by this task since construction
+class Probe {
+public:
+    [[nodiscard]] std::uint32_t count() const { return allocations - start_count_; }
+    [[nodiscard]] std::size_t bytes() const { return allocated_bytes - start_bytes_; }
+
+private:
+    std::uint32_t start_count_ = allocations;
+    std::size_t start_bytes_ = allocated_bytes;
+};
+
+} // namespace alloc
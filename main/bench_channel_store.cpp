@@ -0,0 +1,151 @@
+// bench_channel_store.cpp
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "channel_store.hpp"
+
+//------------------------------------------------------------
+// Multi-channel history: rows (AoS) vs. ChannelStore columns
+//
+// "rows" keeps the same history as an array of per-update rows,
+// so one channel's samples are Channels floats apart and its
+// min/max/mean is a strided scalar loop. "columns" is
+// ChannelStore: contiguous per-channel columns reduced with the
+// simd_reduce.hpp kernels. Reported per row pushed and per
+// channel reduced (cache dropped by a push each time), plus the
+// share of one 1 kHz period spent pushing a row and reducing
+// every channel.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchChannels";
+
+namespace {
+
+constexpr std::size_t DEPTH = 1024;
+constexpr std::size_t PUSHES = 1u << 20;
+constexpr std::size_t INPUTS = 64;
+
+template <std::size_t Channels>
+struct Rows {
+    void push(std::span<const float> row)
+    {
+        std::copy(row.begin(), row.end(), rows[head].begin());
+        head = head + 1 == DEPTH ? 0 : head + 1;
+        size += size < DEPTH;
+    }
+
+    WindowStats<float> stats(std::size_t ch) const
+    {
+        float lo = rows[0][ch];
+        float hi = lo;
+        float sum = 0.0f;
+        for (std::size_t r = 0; r < size; ++r) {
+            const float v = rows[r][ch];
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+            sum += v;
+        }
+        return { lo, hi, sum / static_cast<float>(size), size };
+    }
+
+    std::array<std::array<float, Channels>, DEPTH> rows{};
+    std::size_t head = 0;
+    std::size_t size = 0;
+};
+
+struct Samples {
+    float next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) * 0x1p-24f * 100.0f;
+    }
+    uint32_t state = 12345;
+};
+
+template <std::size_t Channels>
+void measure()
+{
+    const bench::Label label{ "channels=%3zu", Channels };
+    const auto rows = bench::try_make<Rows<Channels>>(TAG, label);
+    const auto store = bench::try_make<ChannelStore<float, Channels, DEPTH>>(TAG, label);
+    if (!rows || !store) {
+        return;
+    }
+    for (std::size_t ch = 0; ch < Channels; ++ch) {
+        store->bind(static_cast<int>(ch + 1));
+    }
+
+    // Inputs drawn up front so only the stores are timed
+    const auto inputs = bench::try_make<std::array<std::array<float, Channels>, INPUTS>>(TAG, label);
+    if (!inputs) {
+        return;
+    }
+    Samples src;
+    for (auto& row : *inputs) {
+        for (float& v : row) {
+            v = src.next();
+        }
+    }
+    const auto input = [&](std::size_t i) -> std::span<const float> { return (*inputs)[i % INPUTS]; };
+
+    const double rows_push_ns = bench::ns_per_op(PUSHES, [&](std::size_t i) {
+        rows->push(input(i));
+        bench::clobber();
+    });
+    const double store_push_ns = bench::ns_per_op(PUSHES, [&](std::size_t i) {
+        store->push(input(i));
+        bench::clobber();
+    });
+
+    // A push before every reduction so the store cannot answer from its
+    // cache; both sides push the same rows, the push cost is taken off
+    constexpr std::size_t REDUCTIONS = 4096;
+    float acc = 0.0f;
+    const double rows_stats_ns = bench::ns_per_op(REDUCTIONS, [&](std::size_t i) {
+        rows->push(input(i));
+        const WindowStats<float> s = rows->stats(i % Channels);
+        acc += s.max - s.min + s.mean;
+    }) - rows_push_ns;
+    const double store_stats_ns = bench::ns_per_op(REDUCTIONS, [&](std::size_t i) {
+        store->push(input(i));
+        const WindowStats<float>& s = store->stats(i % Channels);
+        acc += s.max - s.min + s.mean;
+    }) - store_push_ns;
+    bench::do_not_optimize(acc);
+
+    // Same history, same answers (means may differ in the last bits)
+    bool match = true;
+    for (std::size_t ch = 0; ch < Channels; ++ch) {
+        const WindowStats<float> a = rows->stats(ch);
+        const WindowStats<float>& b = store->stats(ch);
+        match &= a.min == b.min && a.max == b.max && a.count == b.count
+            && std::abs(a.mean - b.mean) < 1e-3f * std::abs(a.mean);
+    }
+
+    const auto budget = [](double push_ns, double stats_ns) {
+        return 100.0 * (push_ns + Channels * stats_ns) / 1e6; // % of 1 ms
+    };
+    ESP_LOGI(TAG, "channels=%3zu  push: rows %6.2f  columns %6.2f ns  |  stats/channel: rows %8.1f  columns %7.1f ns"
+        "  |  1 kHz load: rows %5.2f%%  columns %5.2f%%  |  %s",
+        Channels, rows_push_ns, store_push_ns, rows_stats_ns, store_stats_ns,
+        budget(rows_push_ns, rows_stats_ns), budget(store_push_ns, store_stats_ns),
+        match ? "match" : "MISMATCH");
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "history depth %zu rows", DEPTH);
+    measure<4>();
+    measure<16>();
+    measure<32>();
+    measure<64>();
+}
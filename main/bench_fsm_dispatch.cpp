@@ -0,0 +1,206 @@
+// bench_fsm_dispatch.cpp
+#include <cstdint>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "fsm_event.hpp"
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// std::visit + overload set vs. constexpr transition table,
+// then single-event vs. batched replay of a backlog held as
+// std::variant or fsm::packed_event
+//
+// Both machines implement the same graph with trivial
+// handlers so the measurement is dominated by dispatch:
+//   Idle    --EvInit-->              Running
+//   Running --EvTick[ticks>=limit]-> Error
+//   Running --EvTick-->              (count tick)
+//   Running --EvError-->             Error
+//   Error   --EvInit-->              Idle
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchDispatch";
+
+namespace {
+
+struct EvInit {};
+struct EvTick {};
+struct EvError { int code; };
+
+struct Idle {};
+struct Running { uint32_t ticks = 0; };
+struct Error { int code; };
+
+using State = std::variant<Idle, Running, Error>;
+using Event = std::variant<EvInit, EvTick, EvError>;
+using PackedEvent = fsm::packed_event<EvInit, EvTick, EvError>;
+
+constexpr uint32_t TICK_LIMIT = 1'000'000;
+
+// Shape of StateMachine::dispatch before the table engine
+class VisitMachine {
+public:
+    void dispatch(auto&& event)
+    {
+        std::visit(
+            [this, &event]<typename S>(S& state) {
+                handle(state, event);
+            },
+            state_
+        );
+    }
+
+    uint64_t work = 0;
+
+private:
+    void handle(Idle&, const EvInit&) { state_ = Running{}; }
+
+    void handle(Running& s, const EvTick&)
+    {
+        if (s.ticks >= TICK_LIMIT) {
+            state_ = Error{ -1 };
+        } else {
+            work += ++s.ticks;
+        }
+    }
+
+    void handle(Running&, const EvError& e) { state_ = Error{ e.code }; }
+    void handle(Error&, const EvInit&) { state_ = Idle{}; }
+
+    template <typename S, typename E>
+    void handle(S&, const E&) {}
+
+    State state_{ Idle{} };
+};
+
+class TableMachine {
+public:
+    void dispatch(const auto& event)
+    {
+        Table::dispatch(*this, state_, event);
+    }
+
+    template <typename EventVariant>
+    void dispatch_event(const EventVariant& event)
+    {
+        Table::dispatch_event(*this, state_, event);
+    }
+
+    template <typename EventVariant>
+    void dispatch_many(std::span<const EventVariant> events)
+    {
+        Table::dispatch_many(*this, state_, events);
+    }
+
+    uint64_t work = 0;
+
+private:
+    bool at_limit(const Running& s, const EvTick&) const { return s.ticks >= TICK_LIMIT; }
+
+    Error to_error(Running&, const EvTick&) { return Error{ -1 }; }
+    void count(Running& s, const EvTick&) { work += ++s.ticks; }
+    Error fail(Running&, const EvError& e) { return Error{ e.code }; }
+
+    using Table = fsm::table<TableMachine, State,
+        fsm::transition<Idle,    EvInit,  Running>,
+        fsm::transition<Running, EvTick,  Error,   &TableMachine::to_error, &TableMachine::at_limit>,
+        fsm::internal<Running,   EvTick,           &TableMachine::count>,
+        fsm::transition<Running, EvError, Error,   &TableMachine::fail>,
+        fsm::transition<Error,   EvInit,  Idle>
+    >;
+
+    State state_{ Idle{} };
+};
+
+// Mostly ticks with a periodic error/recover cycle, 67 dispatches per 64 steps
+template <typename Machine>
+double ns_per_dispatch(std::size_t steps)
+{
+    Machine m;
+    m.dispatch(EvInit{});
+    // Machine state lives in memory between events, as it does in the app
+    bench::do_not_optimize(&m);
+
+    const double ns_per_step = bench::ns_per_op(steps, [&m](std::size_t i) {
+        m.dispatch(EvTick{});
+        if ((i & 63) == 63) {
+            m.dispatch(EvError{ static_cast<int>(i) });
+            m.dispatch(EvInit{});
+            m.dispatch(EvInit{});
+        }
+        bench::clobber();
+    });
+    bench::do_not_optimize(m.work);
+    return ns_per_step * 64.0 / 67.0;
+}
+
+// Replays a stalled backlog either one event at a time or as a span
+template <typename EventVariant>
+double events_per_second(std::span<const EventVariant> backlog, std::size_t rounds, bool batched)
+{
+    TableMachine m;
+    m.dispatch(EvInit{});
+    bench::do_not_optimize(&m);
+
+    const double ns_per_round = bench::ns_per_op(rounds, [&m, backlog, batched](std::size_t) {
+        if (batched) {
+            m.dispatch_many(backlog);
+        } else {
+            for (const EventVariant& e : backlog) {
+                m.dispatch_event(e);
+            }
+        }
+        bench::clobber();
+    });
+    bench::do_not_optimize(m.work);
+    return static_cast<double>(backlog.size()) * 1e9 / ns_per_round;
+}
+
+// Backlog after a stall: long tick runs with an occasional error/recover
+template <typename EventVariant>
+void replay(const char* name)
+{
+    std::vector<EventVariant> backlog;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        backlog.emplace_back(EvTick{});
+        if ((i & 63) == 63) {
+            backlog.emplace_back(EvError{ static_cast<int>(i) });
+            backlog.emplace_back(EvInit{});
+            backlog.emplace_back(EvInit{});
+        }
+    }
+    constexpr std::size_t rounds = 1000;
+    const double single = events_per_second<EventVariant>(backlog, rounds, false);
+    const double batched = events_per_second<EventVariant>(backlog, rounds, true);
+
+    ESP_LOGI(TAG, "%s (sizeof %zu, trivially copyable: %s)", name, sizeof(EventVariant),
+        std::is_trivially_copyable_v<EventVariant> ? "yes" : "no");
+    ESP_LOGI(TAG, "  per-event loop     : %.1f Mev/s", single / 1e6);
+    ESP_LOGI(TAG, "  dispatch_many(span): %.1f Mev/s", batched / 1e6);
+    ESP_LOGI(TAG, "  speedup            : %.2fx", batched / single);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    constexpr std::size_t steps = 4'000'000;
+
+    // Warm up caches and branch predictors once for each path
+    ns_per_dispatch<VisitMachine>(steps / 8);
+    ns_per_dispatch<TableMachine>(steps / 8);
+
+    const double visit_ns = ns_per_dispatch<VisitMachine>(steps);
+    const double table_ns = ns_per_dispatch<TableMachine>(steps);
+
+    ESP_LOGI(TAG, "std::visit dispatch : %.2f ns/dispatch", visit_ns);
+    ESP_LOGI(TAG, "table dispatch      : %.2f ns/dispatch", table_ns);
+    ESP_LOGI(TAG, "speedup             : %.2fx", visit_ns / table_ns);
+
+    replay<Event>("std::variant");
+    replay<PackedEvent>("packed_event");
+}
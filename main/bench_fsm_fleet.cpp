@@ -0,0 +1,131 @@
+// bench_fsm_fleet.cpp
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "fsm_fleet.hpp"
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// Stepping N FSM instances: one object per instance vs. FsmFleet
+//
+// Same machine shape as cpp_variant (Idle counter, Running,
+// Error code) with non-logging handlers. "objects" is a vector
+// of std::variant states, each dispatched on its own; "fleet"
+// is FsmFleet over the same table. Every instance gets its own
+// limit, so the fleet ends up spread over all three states.
+// Reported as million instance-steps per second.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchFleet";
+
+namespace {
+
+struct EvInit {};
+struct EvTick {};
+
+struct Idle {
+    uint32_t counter = 0;
+};
+struct Running {
+    uint32_t ticks = 0;
+    uint32_t limit = 0;
+};
+struct Error {
+    uint32_t code = 0;
+};
+
+using State = std::variant<Idle, Running, Error>;
+
+class Machine {
+    Running start(Idle& s, const EvInit&) { return Running{ 0, 4 + s.counter % 13 }; }
+    void count(Idle& s, const EvTick&) { ++s.counter; }
+    void run(Running& s, const EvTick&) { ++s.ticks; }
+    bool exhausted(const Running& s, const EvTick&) const { return s.ticks >= s.limit; }
+    Error fail(Running& s, const EvTick&) { return Error{ s.ticks }; }
+    Idle reset(Error& s, const EvInit&) { return Idle{ s.code }; }
+
+public:
+    using Table = fsm::table<Machine, State,
+        fsm::transition<Idle,    EvInit, Running, &Machine::start>,
+        fsm::internal<Idle,      EvTick, &Machine::count>,
+        fsm::transition<Running, EvTick, Error,   &Machine::fail, &Machine::exhausted>,
+        fsm::internal<Running,   EvTick, &Machine::run>,
+        fsm::transition<Error,   EvInit, Idle,    &Machine::reset>
+    >;
+};
+
+using Table = Machine::Table;
+using Fleet = fsm::FsmFleet<Table>;
+
+constexpr std::size_t FLEET_BYTES = 1 + sizeof(Idle) + sizeof(Running) + sizeof(Error);
+
+// One EvInit every 8 steps, EvTick otherwise
+constexpr bool is_init_step(std::size_t step) { return step % 8 == 0; }
+
+template <typename StepFn>
+double msteps_per_s(std::size_t instances, std::size_t steps, StepFn step_fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t s = 0; s < steps; ++s) {
+        step_fn(s);
+        bench::clobber();
+    }
+    const std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(instances * steps) / us.count();
+}
+
+void measure(std::size_t n)
+{
+    // Keep the total work roughly constant across sizes
+    const std::size_t steps = std::max<std::size_t>(16, (16u << 20) / n);
+
+    // The fleet's vectors cannot report failure, so probe for their size first
+    const bench::Label label{ "N=%6zu", n };
+    const auto objects = bench::try_make<State[]>(TAG, label, n);
+    if (!objects || !bench::try_make<std::byte[]>(TAG, label, n * FLEET_BYTES)) {
+        return;
+    }
+    const auto fleet = std::make_unique<Fleet>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        objects[i] = Idle{ static_cast<uint32_t>(i) };
+        fleet->get<Idle>(i).counter = static_cast<uint32_t>(i);
+    }
+
+    Machine m;
+    bench::do_not_optimize(&m);
+
+    std::size_t object_handled = 0;
+    const double object_rate = msteps_per_s(n, steps, [&](std::size_t s) {
+        for (std::size_t i = 0; i < n; ++i) {
+            object_handled += is_init_step(s) ? Table::dispatch(m, objects[i], EvInit{})
+                                              : Table::dispatch(m, objects[i], EvTick{});
+        }
+    });
+
+    std::size_t fleet_handled = 0;
+    const double fleet_rate = msteps_per_s(n, steps, [&](std::size_t s) {
+        fleet_handled += is_init_step(s) ? fleet->step(m, EvInit{}) : fleet->step(m, EvTick{});
+    });
+
+    ESP_LOGI(TAG, "N=%6zu  objects %7.1f  fleet %7.1f Msteps/s  (%.2fx)  idle/running/error %zu/%zu/%zu  %s",
+        n, object_rate, fleet_rate, fleet_rate / object_rate,
+        fleet->count<Idle>(), fleet->count<Running>(), fleet->count<Error>(),
+        object_handled == fleet_handled ? "match" : "DIFFER");
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "bytes/instance: objects %zu, fleet %zu", sizeof(State), FLEET_BYTES);
+    measure(1'000);
+    measure(10'000);
+    measure(100'000);
+}
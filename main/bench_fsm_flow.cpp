@@ -0,0 +1,155 @@
+// bench_fsm_flow.cpp
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "fsm_flow.hpp"
+
+//------------------------------------------------------------
+// Coroutine flow vs. variant step counter, per tick
+//
+// The 5-step calibration from cpp_span_visit_concept written
+// both ways: a Calibrating state with a step counter that the
+// tick handler advances, and a Calibrating state that owns an
+// fsm::Flow and resumes it. "steady" keeps the procedure
+// running forever (resume vs. visit only); "cycle" runs the
+// full Idle -> Calibrating -> Idle loop, so it includes taking
+// and returning an arena frame every 5 ticks.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchFlow";
+
+namespace {
+
+constexpr int STEPS = 5;
+constexpr float REFERENCE = 22.5f;
+constexpr std::size_t TICKS = 1'000'000;
+
+float reading(std::size_t tick) { return REFERENCE + static_cast<float>(tick % 7) * 0.25f; }
+
+//------------------------------------------------------------
+// Variant with a step counter
+//------------------------------------------------------------
+namespace counter {
+
+struct Idle {};
+struct Calibrating {
+    int step;
+    float offset;
+};
+using State = std::variant<Idle, Calibrating>;
+
+struct Machine {
+    State state{ Idle{} };
+    float result = 0.0f;
+    bool forever = false;
+
+    void tick(float r)
+    {
+        std::visit([this, r]<typename T>(T& s) {
+            if constexpr (std::is_same_v<T, Idle>) {
+                state = Calibrating{ 0, 0.0f };
+            } else {
+                s.offset += r - REFERENCE;
+                if (++s.step == STEPS && !forever) {
+                    result = s.offset / STEPS;
+                    state = Idle{};
+                }
+            }
+        }, state);
+    }
+};
+
+} // namespace counter
+
+//------------------------------------------------------------
+// Variant with a coroutine inside Calibrating
+//------------------------------------------------------------
+namespace coro {
+
+fsm::Flow<float> calibrate(float& result)
+{
+    float offset = 0.0f;
+    for (int step = 0; step < STEPS; ++step) {
+        offset += co_await fsm::next_tick() - REFERENCE;
+    }
+    result = offset / STEPS;
+}
+
+fsm::Flow<float> calibrate_forever(float& result)
+{
+    while (true) {
+        result += co_await fsm::next_tick() - REFERENCE;
+    }
+}
+
+struct Idle {};
+struct Calibrating {
+    fsm::Flow<float> procedure;
+};
+using State = std::variant<Idle, Calibrating>;
+
+struct Machine {
+    State state{ Idle{} };
+    float result = 0.0f;
+    bool forever = false;
+
+    void tick(float r)
+    {
+        std::visit([this, r]<typename T>(T& s) {
+            if constexpr (std::is_same_v<T, Idle>) {
+                state = Calibrating{ forever ? calibrate_forever(result) : calibrate(result) };
+            } else if (!s.procedure.resume(r)) {
+                state = Idle{};
+            }
+        }, state);
+    }
+};
+
+} // namespace coro
+
+template <typename Machine>
+double ns_per_tick(bool forever)
+{
+    Machine m;
+    m.forever = forever;
+    m.tick(0.0f); // Idle -> Calibrating outside the timed loop
+    const double ns = bench::ns_per_op(TICKS, [&m](std::size_t i) {
+        m.tick(reading(i));
+        bench::clobber();
+    });
+    bench::do_not_optimize(m.result);
+    return ns;
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    {
+        float result = 0.0f;
+        const auto once = coro::calibrate(result);
+        const auto forever = coro::calibrate_forever(result);
+        ESP_LOGI(TAG, "frames: calibrate %zu bytes, calibrate_forever %zu bytes (arena blocks %zu bytes)",
+            once.frame_size(), forever.frame_size(), fsm::frame_arena().stats().block_size);
+    }
+    ESP_LOGI(TAG, "state sizes: counter %zu bytes, coroutine %zu bytes (+ frame)",
+        sizeof(counter::State), sizeof(coro::State));
+
+    const double steady_counter = ns_per_tick<counter::Machine>(true);
+    const double steady_coro = ns_per_tick<coro::Machine>(true);
+    ESP_LOGI(TAG, "steady  counter %6.2f ns/tick  coroutine %6.2f ns/tick  (%.2fx)",
+        steady_counter, steady_coro, steady_coro / steady_counter);
+
+    const double cycle_counter = ns_per_tick<counter::Machine>(false);
+    const double cycle_coro = ns_per_tick<coro::Machine>(false);
+    ESP_LOGI(TAG, "cycle   counter %6.2f ns/tick  coroutine %6.2f ns/tick  (%.2fx)",
+        cycle_counter, cycle_coro, cycle_coro / cycle_counter);
+
+    const auto arena = fsm::frame_arena().stats();
+    ESP_LOGI(TAG, "arena: peak %zu/%zu blocks, largest frame %zu bytes, %zu refused",
+        arena.peak, arena.blocks, arena.largest, arena.failures);
+}
@@ -0,0 +1,159 @@
+// bench_fsm_reachability.cpp
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// Unreachable-state stripping on a production-sized table
+//
+// 16 states x 8 events, every cell covered by a guarded
+// transition. Only states 0..7 can be reached from St<0>; the
+// other 8 form a closed "legacy" cluster that nothing enters.
+// The table lists fsm::strip_unreachable, so their 64 cells
+// share the unhandled stub. The host build also compiles this
+// file with BENCH_KEEP_UNREACHABLE=1 (fsm::keep_unreachable,
+// bench_fsm_reachability_keep) and prints the .text of both;
+// on target compare `idf.py size` runs.
+// Dispatch results are identical either way: the checksum
+// below must match between the two binaries.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchReach";
+
+#ifndef BENCH_KEEP_UNREACHABLE
+#  define BENCH_KEEP_UNREACHABLE 0
+#endif
+
+namespace {
+
+constexpr int STATES = 16;
+constexpr int LIVE_STATES = 8;
+constexpr int EVENTS = 8;
+constexpr std::size_t STEPS = 4'000'000;
+
+template <int I>
+struct St {
+    uint32_t value = 0;
+};
+
+template <int K>
+struct Ev {
+    uint32_t v = 0;
+};
+
+// Live states cycle among themselves, legacy states likewise
+template <int I, int K>
+inline constexpr int next_state = I < LIVE_STATES
+    ? (I + K + 1) % LIVE_STATES
+    : LIVE_STATES + (I - LIVE_STATES + K + 1) % (STATES - LIVE_STATES);
+
+template <typename Seq>
+struct variant_of;
+
+template <int... I>
+struct variant_of<std::integer_sequence<int, I...>> {
+    using type = std::variant<St<I>...>;
+};
+
+using State = variant_of<std::make_integer_sequence<int, STATES>>::type;
+
+template <typename Seq>
+struct event_variant_of;
+
+template <int... K>
+struct event_variant_of<std::integer_sequence<int, K...>> {
+    using type = std::variant<Ev<K>...>;
+};
+
+using Event = event_variant_of<std::make_integer_sequence<int, EVENTS>>::type;
+
+class Machine {
+public:
+    void dispatch(const Event& e) { Table::dispatch_event(*this, state_, e); }
+
+    uint64_t checksum = 0;
+
+private:
+    template <int I, int K>
+    bool allowed(const St<I>& s, const Ev<K>& e) const
+    {
+        return ((s.value ^ e.v) + I * 7 + K) % 5 != 0;
+    }
+
+    template <int I, int K>
+    St<next_state<I, K>> go(St<I>& s, const Ev<K>& e)
+    {
+        checksum = checksum * 31 + (s.value ^ (e.v << (K % 7))) + I * EVENTS + K;
+        return St<next_state<I, K>>{ s.value * 3 + e.v + K };
+    }
+
+    template <int I, int K>
+    using row = fsm::transition<St<I>, Ev<K>, St<next_state<I, K>>,
+                                &Machine::go<I, K>, &Machine::allowed<I, K>>;
+
+    template <int I, int... K>
+    static auto rows_for(std::integer_sequence<int, K...>) -> std::tuple<row<I, K>...>;
+
+    template <typename... Tuples>
+    static auto concat(Tuples...) -> decltype(std::tuple_cat(std::declval<Tuples>()...));
+
+    template <typename Rows>
+    struct make_table;
+
+    template <typename... Rows>
+    struct make_table<std::tuple<Rows...>> {
+        using type = fsm::table<Machine, State, Rows...,
+            std::conditional_t<BENCH_KEEP_UNREACHABLE, fsm::keep_unreachable, fsm::strip_unreachable>>;
+    };
+
+    template <int... I>
+    static auto all_rows(std::integer_sequence<int, I...>)
+        -> decltype(concat(rows_for<I>(std::make_integer_sequence<int, EVENTS>{})...));
+
+public:
+    using Table = make_table<decltype(all_rows(std::make_integer_sequence<int, STATES>{}))>::type;
+
+private:
+    State state_{};
+};
+
+using Table = Machine::Table;
+
+static_assert(Table::reachable<St<LIVE_STATES - 1>> && !Table::reachable<St<LIVE_STATES>>);
+static_assert(Table::unreachable_states == STATES - LIVE_STATES);
+
+// Event stream: mixes all types, payload varies per step
+Event event_at(std::size_t i)
+{
+    const auto v = static_cast<uint32_t>(i * 2654435761u);
+    return [v]<int... K>(std::size_t k, std::integer_sequence<int, K...>) {
+        Event e;
+        ((k == static_cast<std::size_t>(K) ? (e = Ev<K>{ v }, true) : false) || ...);
+        return e;
+    }((v >> 11) % EVENTS, std::make_integer_sequence<int, EVENTS>{});
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    constexpr auto report = Table::report<Event>;
+    ESP_LOGI(TAG, "%zu/%zu states reachable, %zu cells, %zu handled, %zu live (strip %s)",
+        report.reachable_states, report.states, report.cells, report.handled_cells, report.live_cells,
+        Table::strips ? "on" : "off");
+
+    Machine m;
+    bench::do_not_optimize(&m);
+    const double ns = bench::ns_per_op(STEPS, [&m](std::size_t i) {
+        m.dispatch(event_at(i));
+        bench::clobber();
+    });
+    ESP_LOGI(TAG, "dispatch %.2f ns/event, checksum %016llx", ns, static_cast<unsigned long long>(m.checksum));
+}
@@ -0,0 +1,121 @@
+// bench_hsm_depth.cpp
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// Hierarchical dispatch cost vs. nesting depth
+//
+// The active leaf sits D levels below the root. EvTick is only
+// handled by the root, so it bubbles through every level; EvSwap
+// moves between two sibling leaves, which must exit and enter
+// just the leaves although every level has entry/exit hooks.
+// Both costs should stay flat from depth 1 to 5.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchHsm";
+
+namespace {
+
+struct EvInit {};
+struct EvTick {};
+struct EvSwap {};
+
+struct Idle {};
+
+template <int D>
+struct Level : Level<D - 1> {
+    using parent = Level<D - 1>;
+};
+
+template <>
+struct Level<0> {
+    uint32_t ticks = 0;
+};
+
+template <int D>
+struct Sibling : Level<D - 1> {
+    using parent = Level<D - 1>;
+};
+
+template <int D>
+class Machine {
+public:
+    void dispatch(const auto& event)
+    {
+        Table::dispatch(*this, state_, event);
+    }
+
+    uint64_t work = 0;
+    uint32_t hooks = 0;
+
+private:
+    using Leaf = Level<D>;
+    using Other = Sibling<D>;
+    using State = std::variant<Idle, Leaf, Other>;
+
+    void count(Level<0>& root, const EvTick&) { work += ++root.ticks; }
+    Other swap_out(Leaf& s, const EvSwap&) { return Other{ s }; }
+    Leaf swap_in(Other& s, const EvSwap&) { return Leaf{ s }; }
+
+    template <typename X>
+    void hook(X&) { ++hooks; }
+
+    template <std::size_t... K>
+    static auto make_table(std::index_sequence<K...>) -> fsm::table<Machine, State,
+        fsm::transition<Idle,  EvInit, Leaf>,
+        fsm::transition<Leaf,  EvSwap, Other, &Machine::swap_out>,
+        fsm::transition<Other, EvSwap, Leaf,  &Machine::swap_in>,
+        fsm::internal<Level<0>, EvTick, &Machine::count>,
+        fsm::on_entry<Leaf,  &Machine::template hook<Leaf>>,
+        fsm::on_exit<Leaf,   &Machine::template hook<Leaf>>,
+        fsm::on_entry<Other, &Machine::template hook<Other>>,
+        fsm::on_exit<Other,  &Machine::template hook<Other>>,
+        fsm::on_entry<Level<K>, &Machine::template hook<Level<K>>>...,
+        fsm::on_exit<Level<K>,  &Machine::template hook<Level<K>>>...
+    >;
+
+    using Table = decltype(make_table(std::make_index_sequence<D>{}));
+
+    State state_{ Idle{} };
+};
+
+template <int D>
+void measure()
+{
+    constexpr std::size_t steps = 2'000'000;
+
+    Machine<D> m;
+    m.dispatch(EvInit{});
+    bench::do_not_optimize(&m);
+
+    const double tick_ns = bench::ns_per_op(steps, [&m](std::size_t) {
+        m.dispatch(EvTick{});
+        bench::clobber();
+    });
+
+    const uint32_t hooks_before = m.hooks;
+    const double swap_ns = bench::ns_per_op(steps, [&m](std::size_t) {
+        m.dispatch(EvSwap{});
+        bench::clobber();
+    });
+    bench::do_not_optimize(m.work);
+
+    ESP_LOGI(TAG, "depth %d: bubbled tick %.2f ns, sibling swap %.2f ns, hooks/swap %.1f",
+        D, tick_ns, swap_ns, static_cast<double>(m.hooks - hooks_before) / steps);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    measure<1>();
+    measure<2>();
+    measure<3>();
+    measure<4>();
+    measure<5>();
+}
@@ -0,0 +1,136 @@
+// bench_running_ring.cpp
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "running_ring.hpp"
+
+//------------------------------------------------------------
+// Window mean per new sample: rescan vs. RunningRing
+//
+// "rescan" re-sums the whole ring after every push, which is
+// what the MonitoringState branch did. "running" keeps a plain
+// float sum (+new -evicted), "ring" is RunningRing with its
+// compensated sum. Reported as ns per sample, plus how far the
+// final mean of the two O(1) variants drifted from an exact
+// double-precision re-sum of the window.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchRing";
+
+namespace {
+
+template <std::size_t N>
+struct PlainRing {
+    void push(float v)
+    {
+        data[head++ % N] = v;
+        size = std::min(size + 1, N);
+    }
+    std::array<float, N> data{};
+    std::size_t head = 0;
+    std::size_t size = 0;
+};
+
+template <std::size_t N>
+struct RunningSum {
+    void push(float v)
+    {
+        if (ring.size == N) {
+            sum -= ring.data[ring.head % N];
+        }
+        sum += v;
+        ring.push(v);
+    }
+    PlainRing<N> ring;
+    float sum = 0.0f;
+};
+
+// Positive readings with noise around a large offset, the hard case
+struct Samples {
+    float next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return 1013.25f + static_cast<float>(state >> 8) * 0x1p-24f * 5.0f;
+    }
+    uint32_t state = 12345;
+};
+
+template <std::size_t N>
+double exact_mean(const PlainRing<N>& ring)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < ring.size; ++i) {
+        sum += ring.data[i];
+    }
+    return sum / static_cast<double>(ring.size);
+}
+
+template <std::size_t N>
+void measure()
+{
+    // Fewer pushes for big windows so the rescan finishes in reasonable time;
+    // drift is measured over a longer stream
+    const std::size_t pushes = std::max<std::size_t>(2 * N, (1u << 22) / N);
+    constexpr std::size_t drift_pushes = 1u << 22;
+
+    const bench::Label label{ "N=%6zu", N };
+    const auto plain = bench::try_make<PlainRing<N>>(TAG, label);
+    const auto running = bench::try_make<RunningSum<N>>(TAG, label);
+    const auto ring = bench::try_make<RunningRing<float, N>>(TAG, label);
+    if (!plain || !running || !ring) {
+        return;
+    }
+
+    Samples rescan_src;
+    float rescan_acc = 0.0f;
+    const double rescan_ns = bench::ns_per_op(pushes, [&](std::size_t) {
+        plain->push(rescan_src.next());
+        float sum = 0.0f;
+        for (const float v : std::span{ plain->data }.first(plain->size)) {
+            sum += v;
+        }
+        rescan_acc += sum / static_cast<float>(plain->size);
+    });
+
+    Samples running_src;
+    float running_acc = 0.0f;
+    const double running_ns = bench::ns_per_op(drift_pushes, [&](std::size_t) {
+        running->push(running_src.next());
+        running_acc += running->sum / static_cast<float>(running->ring.size);
+    });
+
+    Samples ring_src;
+    float ring_acc = 0.0f;
+    const double ring_ns = bench::ns_per_op(drift_pushes, [&](std::size_t) {
+        ring->push(ring_src.next());
+        ring_acc += ring->mean();
+    });
+
+    bench::do_not_optimize(rescan_acc);
+    bench::do_not_optimize(running_acc);
+    bench::do_not_optimize(ring_acc);
+
+    const double exact = exact_mean(running->ring);
+    const double running_err = std::abs(running->sum / static_cast<double>(running->ring.size) - exact);
+    const double ring_err = std::abs(static_cast<double>(ring->mean()) - exact);
+    ESP_LOGI(TAG, "N=%6zu  rescan %10.2f  running %5.2f  ring %5.2f ns/sample  |  mean error running %.2e  ring %.2e",
+        N, rescan_ns, running_ns, ring_ns, running_err, ring_err);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    measure<8>();
+    measure<64>();
+    measure<512>();
+    measure<4096>();
+    measure<32768>();
+    measure<65536>();
+}
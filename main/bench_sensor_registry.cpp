@@ -0,0 +1,157 @@
+// bench_sensor_registry.cpp
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "sensor_registry.hpp"
+#include "sim_sensors.hpp"
+
+//------------------------------------------------------------
+// Polling N sensors: variadic pack vs. sensors::SensorRegistry
+//
+// A quarter of the sensors (at least one) are FifoNoiseSensor
+// handing over FIFO_DEPTH samples per poll, the rest
+// ScalarNoiseSensor. "variadic" passes every sensor to one function
+// template, as process_sensors(Sensors&&...) does: the reads are
+// inlined and the set is fixed at compile time. "registry" polls
+// identical sensors through SensorRegistry::poll, one indirect
+// call per sensor. Both sum every sample they see; the sums must
+// match. Reported as ns per poll cycle and per sensor.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchRegistry";
+
+namespace {
+
+constexpr std::size_t FIFO_DEPTH = 8;
+constexpr std::size_t BLOCK = 32;
+constexpr std::size_t WORK_PER_POINT = 1u << 21; // sensor polls per measurement
+
+template <std::size_t N>
+constexpr std::size_t FIFOS = std::max<std::size_t>(1, N / 4);
+
+sim::FifoNoiseSensor make_fifo(std::size_t i)
+{
+    return { static_cast<int>(i), 20.0f, 1.0f, static_cast<std::uint32_t>(i), FIFO_DEPTH };
+}
+
+sim::ScalarNoiseSensor make_plain(std::size_t i)
+{
+    return { static_cast<int>(i), 50.0f, 2.0f, static_cast<std::uint32_t>(i) };
+}
+
+// N sensors by value, as a fixed compile-time set would hold them
+template <std::size_t N>
+struct Fleet {
+    template <std::size_t... F, std::size_t... P>
+    Fleet(std::index_sequence<F...>, std::index_sequence<P...>)
+        : fifo{ make_fifo(F)... }, plain{ make_plain(FIFOS<N> + P)... }
+    {}
+    Fleet() : Fleet{ std::make_index_sequence<FIFOS<N>>{}, std::make_index_sequence<N - FIFOS<N>>{} } {}
+
+    std::array<sim::FifoNoiseSensor, FIFOS<N>> fifo;
+    std::array<sim::ScalarNoiseSensor, N - FIFOS<N>> plain;
+};
+
+template <SensorType S>
+float read_latest(S& sensor, float& sum)
+{
+    if constexpr (BlockSensorType<S>) {
+        std::array<float, BLOCK> block;
+        const std::size_t count = std::min(sensor.read_into(block), BLOCK);
+        if (count != 0) {
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += block[i];
+            }
+            return block[count - 1];
+        }
+    }
+    const float value = sensor.read();
+    sum += value;
+    return value;
+}
+
+template <SensorType... Sensors>
+float poll_variadic(std::span<float> latest, Sensors&... sensors)
+{
+    float sum = 0.0f;
+    std::size_t i = 0;
+    ((latest[i++] = read_latest(sensors, sum)), ...);
+    return sum;
+}
+
+template <std::size_t N, std::size_t... F, std::size_t... P>
+float poll_fleet(Fleet<N>& fleet, std::span<float> latest, std::index_sequence<F...>, std::index_sequence<P...>)
+{
+    return poll_variadic(latest, fleet.fifo[F]..., fleet.plain[P]...);
+}
+
+template <std::size_t N>
+using Registry = sensors::SensorRegistry<N,
+    FIFOS<N> * sizeof(sim::FifoNoiseSensor) + (N - FIFOS<N>) * sizeof(sim::ScalarNoiseSensor), BLOCK>;
+
+template <std::size_t N>
+void measure()
+{
+    const bench::Label label{ "sensors=%3zu", N };
+    const auto fleet = bench::try_make<Fleet<N>>(TAG, label);
+    const auto registry = bench::try_make<Registry<N>>(TAG, label);
+    if (!fleet || !registry) {
+        return;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        const bool added = i < FIFOS<N> ? registry->template add<sim::FifoNoiseSensor>(make_fifo(i)) != nullptr
+                                        : registry->template add<sim::ScalarNoiseSensor>(make_plain(i)) != nullptr;
+        if (!added) {
+            ESP_LOGE(TAG, "sensors=%3zu  registry full at %zu", N, i);
+            return;
+        }
+    }
+
+    const std::size_t cycles = std::max<std::size_t>(1000, WORK_PER_POINT / N);
+    std::array<float, N> latest{};
+
+    float variadic_sum = 0.0f;
+    const double variadic_ns = bench::ns_per_op(cycles, [&](std::size_t) {
+        variadic_sum += poll_fleet(*fleet, latest, std::make_index_sequence<FIFOS<N>>{},
+            std::make_index_sequence<N - FIFOS<N>>{});
+        bench::clobber();
+    });
+
+    float registry_sum = 0.0f;
+    const double registry_ns = bench::ns_per_op(cycles, [&](std::size_t) {
+        float sum = 0.0f;
+        registry->poll(latest, [&sum](std::size_t, std::span<const float> samples) {
+            for (const float v : samples) {
+                sum += v;
+            }
+        });
+        registry_sum += sum;
+        bench::clobber();
+    });
+    bench::do_not_optimize(latest);
+
+    ESP_LOGI(TAG, "sensors=%3zu  variadic %9.1f ns/cycle %6.1f ns/sensor", N, variadic_ns, variadic_ns / N);
+    ESP_LOGI(TAG, "sensors=%3zu  registry %9.1f ns/cycle %6.1f ns/sensor  %5.2fx  %zu bytes",
+        N, registry_ns, registry_ns / N, registry_ns / variadic_ns, sizeof(Registry<N>));
+    if (variadic_sum != registry_sum) {
+        ESP_LOGE(TAG, "sensors=%3zu  MISMATCH: %f vs %f", N, variadic_sum, registry_sum);
+    }
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "sensors of %zu / %zu bytes, FIFO sensors hand over %zu samples per poll",
+        sizeof(sim::ScalarNoiseSensor), sizeof(sim::FifoNoiseSensor), FIFO_DEPTH);
+    measure<3>();
+    measure<32>();
+    measure<256>();
+}
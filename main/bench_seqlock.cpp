@@ -0,0 +1,155 @@
+// bench_seqlock.cpp
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_log.h>
+#include <esp_pthread.h>
+
+#include "seqlock.hpp"
+
+//------------------------------------------------------------
+// Snapshot publishing: SeqLock vs. mutex, 1-4 readers
+//
+// One writer pinned to core 1 publishes snapshots shaped like
+// ManagerSnapshot as fast as it can for RUN_TIME; readers on
+// core 0 (and unpinned ones beyond the first) load them in a
+// loop. Every field is derived from one counter, so a reader
+// can tell a torn copy from a consistent one. Reported: writer
+// and total reader rates in M/s, reader retries (seqlock) and
+// torn snapshots, which must be zero for both.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchSeqLock";
+
+namespace {
+
+using namespace std::chrono_literals;
+constexpr auto RUN_TIME = 300ms;
+
+struct Snapshot {
+    std::uint32_t state;
+    std::uint32_t samples;
+    float min;
+    float max;
+    float mean;
+    std::size_t count;
+
+    bool operator==(const Snapshot&) const = default;
+};
+
+Snapshot make(std::uint32_t n)
+{
+    const auto base = static_cast<float>(n & 0xFFFFu);
+    return { n & 3u, n, base, base + 1.0f, base + 0.5f, n };
+}
+
+bool consistent(const Snapshot& s)
+{
+    return s == make(s.samples);
+}
+
+// Baseline: same interface, a mutex around the copy
+class Locked {
+public:
+    void store(const Snapshot& s)
+    {
+        std::lock_guard lock{ mutex_ };
+        value_ = s;
+    }
+    bool try_load(Snapshot& out) const
+    {
+        std::lock_guard lock{ mutex_ };
+        out = value_;
+        return true;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    Snapshot value_ = make(0);
+};
+
+template <typename F>
+std::jthread spawn(const char* name, int core, F&& fn)
+{
+    auto cfg = esp_pthread_get_default_config();
+    cfg.thread_name = name;
+    cfg.pin_to_core = core;
+    cfg.stack_size = 4096;
+    esp_pthread_set_cfg(&cfg);
+    std::jthread thread{ std::forward<F>(fn) };
+    const auto reset = esp_pthread_get_default_config();
+    esp_pthread_set_cfg(&reset);
+    return thread;
+}
+
+struct Counts {
+    std::uint64_t reads = 0;
+    std::uint64_t retries = 0;
+    std::uint64_t torn = 0;
+};
+
+template <typename Box>
+void run(const char* name, std::size_t readers)
+{
+    Box box;
+    box.store(make(0));
+    std::atomic<bool> running{ true };
+    std::uint32_t stores = 0;
+    std::vector<Counts> counts(readers);
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t r = 0; r < readers; ++r) {
+            threads.push_back(spawn("reader", r == 0 ? 0 : tskNO_AFFINITY, [&box, &running, &c = counts[r]] {
+                Snapshot s;
+                while (running.load(std::memory_order_relaxed)) {
+                    if (!box.try_load(s)) {
+                        ++c.retries;
+                        std::this_thread::yield(); // as SeqLock::load does
+                        continue;
+                    }
+                    ++c.reads;
+                    c.torn += !consistent(s);
+                }
+            }));
+        }
+        threads.push_back(spawn("writer", 1, [&] {
+            const auto end = std::chrono::steady_clock::now() + RUN_TIME;
+            do {
+                for (int i = 0; i < 256; ++i) {
+                    box.store(make(++stores));
+                }
+            } while (std::chrono::steady_clock::now() < end);
+            running.store(false, std::memory_order_relaxed);
+        }));
+    }
+    const std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - start;
+
+    Counts total;
+    for (const Counts& c : counts) {
+        total.reads += c.reads;
+        total.retries += c.retries;
+        total.torn += c.torn;
+    }
+    ESP_LOGI(TAG, "%-7s readers=%zu  writer %6.2f M/s  reads %7.2f M/s  retries %8llu  torn %llu",
+        name, readers, stores / us.count(), static_cast<double>(total.reads) / us.count(),
+        static_cast<unsigned long long>(total.retries), static_cast<unsigned long long>(total.torn));
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "%zu-byte snapshot, %u hardware threads", sizeof(Snapshot), std::thread::hardware_concurrency());
+    for (const std::size_t readers : { 1u, 2u, 4u }) {
+        run<lockfree::SeqLock<Snapshot>>("seqlock", readers);
+        run<Locked>("mutex", readers);
+    }
+}
@@ -0,0 +1,128 @@
+// bench_simd_reduce.cpp
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "simd_reduce.hpp"
+
+//------------------------------------------------------------
+// Correctness check + throughput of the simd_reduce kernels
+//
+// Every compiled-in backend is checked against backend::scalar
+// on odd lengths (to exercise the tails) and then timed on a
+// 4K-element buffer. Build the host target with -mavx2 to get
+// the AVX2 rows as well.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchSimd";
+
+namespace {
+
+struct Lcg {
+    uint32_t next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    }
+    uint32_t state = 2024;
+};
+
+std::vector<int> make_ints(std::size_t n, Lcg& rng)
+{
+    std::vector<int> v(n);
+    for (auto& x : v) {
+        x = static_cast<int>(rng.next()) >> 4;
+    }
+    return v;
+}
+
+std::vector<float> make_floats(std::size_t n, Lcg& rng)
+{
+    std::vector<float> v(n);
+    for (auto& x : v) {
+        x = static_cast<float>(rng.next() >> 8) * 1e-3f - 8000.0f;
+    }
+    return v;
+}
+
+template <typename Backend>
+std::size_t check(const char* name)
+{
+    using ref = simd::backend::scalar;
+    Lcg rng;
+    std::size_t failures = 0;
+    for (std::size_t n = 1; n < 4200; n = n < 80 ? n + 1 : n * 2 + 3) {
+        const auto ints = make_ints(n, rng);
+        const auto floats = make_floats(n, rng);
+        const std::span<const int> is{ ints };
+        const std::span<const float> fs{ floats };
+
+        const auto imm = Backend::minmax(is);
+        const auto fmm = Backend::minmax(fs);
+        const auto ref_imm = ref::minmax(is);
+        const auto ref_fmm = ref::minmax(fs);
+        const float ref_fsum = ref::sum(fs);
+        const float tolerance = 1e-5f * static_cast<float>(n) * 8000.0f;
+
+        failures += Backend::min(is) != ref::min(is) || Backend::max(is) != ref::max(is);
+        failures += imm.min != ref_imm.min || imm.max != ref_imm.max;
+        failures += Backend::sum(is) != ref::sum(is);
+        failures += Backend::min(fs) != ref::min(fs) || Backend::max(fs) != ref::max(fs);
+        failures += fmm.min != ref_fmm.min || fmm.max != ref_fmm.max;
+        failures += std::fabs(Backend::sum(fs) - ref_fsum) > tolerance;
+    }
+    ESP_LOGI(TAG, "%-6s correctness: %s (%zu mismatches)", name, failures ? "FAIL" : "ok", failures);
+    return failures;
+}
+
+template <typename Backend>
+void throughput(const char* name)
+{
+    constexpr std::size_t n = 4096;
+    constexpr std::size_t rounds = 20'000;
+    Lcg rng;
+    const auto ints = make_ints(n, rng);
+    const auto floats = make_floats(n, rng);
+    const std::span<const int> is{ ints };
+    const std::span<const float> fs{ floats };
+
+    auto rate = [](double ns_per_call) { return static_cast<double>(n) / ns_per_call * 1e3; };
+
+    const double i_min = bench::ns_per_op(rounds, [is](std::size_t) { bench::do_not_optimize(Backend::min(is)); });
+    const double i_mm = bench::ns_per_op(rounds, [is](std::size_t) { bench::do_not_optimize(Backend::minmax(is)); });
+    const double i_sum = bench::ns_per_op(rounds, [is](std::size_t) { bench::do_not_optimize(Backend::sum(is)); });
+    const double f_min = bench::ns_per_op(rounds, [fs](std::size_t) { bench::do_not_optimize(Backend::min(fs)); });
+    const double f_mm = bench::ns_per_op(rounds, [fs](std::size_t) { bench::do_not_optimize(Backend::minmax(fs)); });
+    const double f_sum = bench::ns_per_op(rounds, [fs](std::size_t) { bench::do_not_optimize(Backend::sum(fs)); });
+
+    ESP_LOGI(TAG, "%-6s int   min %7.0f  minmax %7.0f  sum %7.0f Melem/s",
+        name, rate(i_min), rate(i_mm), rate(i_sum));
+    ESP_LOGI(TAG, "%-6s float min %7.0f  minmax %7.0f  sum %7.0f Melem/s",
+        name, rate(f_min), rate(f_mm), rate(f_sum));
+}
+
+template <typename Backend>
+void run(const char* name)
+{
+    check<Backend>(name);
+    throughput<Backend>(name);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    run<simd::backend::scalar>("scalar");
+#if defined(__SSE2__)
+    run<simd::backend::sse2>("sse2");
+#endif
+#if defined(__AVX2__)
+    run<simd::backend::avx2>("avx2");
+#endif
+#if defined(SIMD_REDUCE_HAS_PIE)
+    run<simd::backend::pie>("pie");
+#endif
+}
@@ -0,0 +1,103 @@
+// bench_sliding_window.cpp
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "sliding_window.hpp"
+
+//------------------------------------------------------------
+// Rescan vs. incremental min/max per new sample
+//
+// "rescan" keeps a plain ring and walks all of it after every
+// push, which is what minmax_samples did on each EvTick.
+// "window" is MinMaxWindow. Reported as ns per sample.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchWindow";
+
+namespace {
+
+// Previous StateMachine::minmax_samples
+auto minmax_samples(std::span<const int> s)
+{
+    int min = s.front();
+    int max = s.front();
+    for (const int v : s.subspan(1)) {
+        min = std::min(min, v);
+        max = std::max(max, v);
+    }
+    return std::pair{ min, max };
+}
+
+template <std::size_t N>
+struct RescanRing {
+    void push(int v)
+    {
+        data[head++ % N] = v;
+        size = std::min(size + 1, N);
+    }
+    std::array<int, N> data{};
+    std::size_t head = 0;
+    std::size_t size = 0;
+};
+
+// Cheap LCG so the deques see a realistic, non-monotonic stream
+struct Samples {
+    int next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int>(state >> 24);
+    }
+    uint32_t state = 12345;
+};
+
+template <std::size_t N>
+void measure()
+{
+    // Fewer pushes for big windows so the rescan finishes in reasonable time
+    const std::size_t pushes = std::max<std::size_t>(2 * N, (1u << 22) / N);
+
+    const bench::Label label{ "N=%6zu", N };
+    const auto ring = bench::try_make<RescanRing<N>>(TAG, label);
+    const auto window = bench::try_make<MinMaxWindow<int, N>>(TAG, label);
+    if (!ring || !window) {
+        return;
+    }
+
+    Samples rescan_src;
+    int64_t rescan_acc = 0;
+    const double rescan_ns = bench::ns_per_op(pushes, [&](std::size_t) {
+        ring->push(rescan_src.next());
+        const auto [min, max] = minmax_samples(std::span{ ring->data }.first(ring->size));
+        rescan_acc += max - min;
+    });
+
+    Samples window_src;
+    int64_t window_acc = 0;
+    const double window_ns = bench::ns_per_op(pushes, [&](std::size_t) {
+        window->push(window_src.next());
+        window_acc += window->max() - window->min();
+    });
+
+    bench::do_not_optimize(rescan_acc);
+    bench::do_not_optimize(window_acc);
+    ESP_LOGI(TAG, "N=%6zu  rescan %10.2f ns/sample  window %6.2f ns/sample  results %s",
+        N, rescan_ns, window_ns, rescan_acc == window_acc ? "match" : "DIFFER");
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    measure<8>();
+    measure<64>();
+    measure<512>();
+    measure<4096>();
+    measure<32768>();
+    measure<65536>();
+}
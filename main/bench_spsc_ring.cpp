@@ -0,0 +1,205 @@
+// bench_spsc_ring.cpp
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_pthread.h>
+
+#include "cycles.hpp"
+#include "mpsc_queue.hpp"
+#include "spsc_ring.hpp"
+
+//------------------------------------------------------------
+// Cross-core sample handoff through lockfree::SpscRing
+//
+// Throughput: a producer pinned to core 0 streams numbered
+// samples to a consumer on core 1, one element per call, in
+// 32-sample blocks, and through MpscQueue for comparison; the
+// consumer checks the sequence. Latency: a sample stamped on
+// core 0 is echoed back from core 1 through a second ring and
+// half the round trip is recorded, so both timestamps come from
+// the same core's counter. Percentiles over all round trips.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchSpsc";
+
+namespace {
+
+constexpr std::size_t CAPACITY = 1024;
+constexpr std::size_t BLOCK = 32;
+constexpr std::uint32_t SAMPLES = 4'000'000;
+constexpr std::size_t ROUND_TRIPS = 100'000;
+
+using Ring = lockfree::SpscRing<std::uint32_t, CAPACITY>;
+using Queue = lockfree::MpscQueue<std::uint32_t, CAPACITY, lockfree::untimed_clock>;
+
+// Starts fn on `core` through the esp_pthread config, as the examples do
+template <typename F>
+std::jthread spawn(const char* name, int core, F&& fn)
+{
+    auto cfg = esp_pthread_get_default_config();
+    cfg.thread_name = name;
+    cfg.pin_to_core = core;
+    cfg.stack_size = 4096;
+    esp_pthread_set_cfg(&cfg);
+    std::jthread thread{ std::forward<F>(fn) };
+    const auto reset = esp_pthread_get_default_config();
+    esp_pthread_set_cfg(&reset);
+    return thread;
+}
+
+// Spins on fn() until it reports progress; yields so one CPU still works
+template <typename F>
+void until(F&& fn)
+{
+    while (!fn()) {
+        std::this_thread::yield();
+    }
+}
+
+struct Result {
+    double msamples_per_s;
+    std::uint32_t errors;
+};
+
+template <typename Produce, typename Consume>
+Result stream(Produce produce, Consume consume)
+{
+    std::uint32_t errors = 0;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::jthread producer = spawn("producer", 0, produce);
+        std::jthread consumer = spawn("consumer", 1, [&] { errors = consume(); });
+    }
+    const std::chrono::duration<double, std::micro> us = std::chrono::steady_clock::now() - start;
+    return { SAMPLES / us.count(), errors };
+}
+
+Result single(Ring& ring)
+{
+    return stream(
+        [&] {
+            for (std::uint32_t i = 0; i < SAMPLES; ++i) {
+                until([&] { return ring.try_push(i); });
+            }
+        },
+        [&] {
+            std::uint32_t errors = 0;
+            for (std::uint32_t i = 0; i < SAMPLES; ++i) {
+                std::uint32_t v = 0;
+                until([&] { return ring.try_pop(v); });
+                errors += v != i;
+            }
+            return errors;
+        });
+}
+
+Result bulk(Ring& ring)
+{
+    return stream(
+        [&] {
+            std::array<std::uint32_t, BLOCK> block;
+            for (std::uint32_t i = 0; i < SAMPLES;) {
+                const std::size_t want = std::min<std::size_t>(BLOCK, SAMPLES - i);
+                for (std::size_t k = 0; k < want; ++k) {
+                    block[k] = i + static_cast<std::uint32_t>(k);
+                }
+                std::span<const std::uint32_t> rest{ block.data(), want };
+                while (!rest.empty()) {
+                    const std::size_t n = ring.push(rest);
+                    rest = rest.subspan(n);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+                i += static_cast<std::uint32_t>(want);
+            }
+        },
+        [&] {
+            std::uint32_t errors = 0;
+            std::array<std::uint32_t, BLOCK> block;
+            for (std::uint32_t i = 0; i < SAMPLES;) {
+                const std::size_t n = ring.pop(block);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (const std::uint32_t v : std::span{ block }.first(n)) {
+                    errors += v != i++;
+                }
+            }
+            return errors;
+        });
+}
+
+Result mpsc(Queue& queue)
+{
+    return stream(
+        [&] {
+            for (std::uint32_t i = 0; i < SAMPLES; ++i) {
+                until([&] { return queue.try_push(i); });
+            }
+        },
+        [&] {
+            std::uint32_t errors = 0;
+            for (std::uint32_t i = 0; i < SAMPLES;) {
+                if (queue.drain([&](std::uint32_t v) { errors += v != i++; }) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            return errors;
+        });
+}
+
+void latency(Ring& there, Ring& back)
+{
+    std::vector<std::uint32_t> one_way(ROUND_TRIPS);
+    {
+        std::jthread echo = spawn("echo", 1, [&] {
+            for (std::size_t i = 0; i < ROUND_TRIPS; ++i) {
+                std::uint32_t stamp = 0;
+                until([&] { return there.try_pop(stamp); });
+                until([&] { return back.try_push(stamp); });
+            }
+        });
+        std::jthread pinger = spawn("pinger", 0, [&] {
+            for (std::size_t i = 0; i < ROUND_TRIPS; ++i) {
+                until([&] { return there.try_push(cycles::now()); });
+                std::uint32_t stamp = 0;
+                until([&] { return back.try_pop(stamp); });
+                one_way[i] = (cycles::now() - stamp) / 2;
+            }
+        });
+    }
+    std::ranges::sort(one_way);
+    const auto pct = [&](double p) { return one_way[static_cast<std::size_t>(p * (ROUND_TRIPS - 1))]; };
+    ESP_LOGI(TAG, "latency (%s, one way): p50 %lu  p90 %lu  p99 %lu  p99.9 %lu  max %lu",
+        cycles::unit,
+        static_cast<unsigned long>(pct(0.50)), static_cast<unsigned long>(pct(0.90)),
+        static_cast<unsigned long>(pct(0.99)), static_cast<unsigned long>(pct(0.999)),
+        static_cast<unsigned long>(one_way.back()));
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "%lu samples, capacity %zu, block %zu, %u hardware threads",
+        static_cast<unsigned long>(SAMPLES), CAPACITY, BLOCK, std::thread::hardware_concurrency());
+
+    // Fresh rings per run; too big for a task stack
+    const Result one = single(*std::make_unique<Ring>());
+    const Result block = bulk(*std::make_unique<Ring>());
+    const Result queue = mpsc(*std::make_unique<Queue>());
+    ESP_LOGI(TAG, "spsc single %7.2f  spsc block %7.2f  mpsc %7.2f Msamples/s  |  sequence errors %lu/%lu/%lu",
+        one.msamples_per_s, block.msamples_per_s, queue.msamples_per_s,
+        static_cast<unsigned long>(one.errors), static_cast<unsigned long>(block.errors),
+        static_cast<unsigned long>(queue.errors));
+
+    latency(*std::make_unique<Ring>(), *std::make_unique<Ring>());
+}
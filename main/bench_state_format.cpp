@@ -0,0 +1,100 @@
+// bench_state_format.cpp
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+
+#include <esp_log.h>
+
+#include "alloc_count.hpp"
+#include "bench_util.hpp"
+#include "log_gate.hpp"
+
+//------------------------------------------------------------
+// Cost of one state description per update
+//
+// "string" is the old get_state_info: std::format into a fresh
+// std::string. "buffer" is std::format_to_n into a stack array,
+// as describe_state does now. "gated" wraps the buffer path in
+// logfmt::enabled with the tag filtered out, which is what an
+// update pays when INFO is off. ns and heap allocations (through
+// operator new, per alloc::Probe) per call.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchFormat";
+
+namespace {
+
+constexpr std::size_t CALLS = 200'000;
+constexpr const char* QUIET_TAG = "Quiet";
+
+// Like every description, longer than libstdc++'s 15-byte SSO buffer
+struct Monitoring {
+    float average_value;
+    int sample_count;
+};
+
+std::string describe_string(const Monitoring& m)
+{
+    return std::format("Monitoring - Avg: {:.2f}, Samples: {}", m.average_value, m.sample_count);
+}
+
+const char* describe_buffer(const Monitoring& m, std::span<char> out)
+{
+    char* const end = std::format_to_n(out.data(), out.size() - 1, "Monitoring - Avg: {:.2f}, Samples: {}",
+        m.average_value, m.sample_count).out;
+    *end = '\0';
+    return out.data();
+}
+
+struct Result {
+    double ns;
+    double allocations;
+    double bytes;
+};
+
+template <typename F>
+Result measure(F&& fn)
+{
+    const alloc::Probe heap;
+    const double ns = bench::ns_per_op(CALLS, fn);
+    return { ns, static_cast<double>(heap.count()) / CALLS, static_cast<double>(heap.bytes()) / CALLS };
+}
+
+void report(const char* name, const Result& r)
+{
+    ESP_LOGI(TAG, "%-7s %7.1f ns  %6.2f allocations  %7.1f bytes per call", name, r.ns, r.allocations, r.bytes);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    Monitoring state{ 24.37f, 1 };
+
+    report("string", measure([&](std::size_t i) {
+        state.sample_count = static_cast<int>(i);
+        const std::string info = describe_string(state);
+        bench::do_not_optimize(info.data());
+    }));
+
+    report("buffer", measure([&](std::size_t i) {
+        state.sample_count = static_cast<int>(i);
+        std::array<char, 96> info;
+        bench::do_not_optimize(describe_buffer(state, info));
+    }));
+
+    // The host shim has one level for all tags: restore it before reporting
+    esp_log_level_set(QUIET_TAG, ESP_LOG_WARN);
+    const Result gated = measure([&](std::size_t i) {
+        state.sample_count = static_cast<int>(i);
+        if (logfmt::enabled(QUIET_TAG, ESP_LOG_INFO)) {
+            std::array<char, 96> info;
+            bench::do_not_optimize(describe_buffer(state, info));
+        }
+        bench::clobber();
+    });
+    esp_log_level_set(QUIET_TAG, ESP_LOG_INFO);
+    report("gated", gated);
+}
@@ -0,0 +1,199 @@
+// bench_timer_wheel.cpp
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "sim_clock.hpp"
+#include "timer_wheel.hpp"
+
+//------------------------------------------------------------
+// 10K periodic timers, one per FSM: TimerWheel vs. a binary heap
+//
+// Each timer stands for an FSM that wants EvTick every 10..1000
+// ticks; firing bumps that FSM's tick counter. The heap baseline
+// is std::priority_queue with lazy cancellation (generation
+// check on pop), i.e. O(log n) schedule and fire. Reported:
+// schedule / cancel cost, steady-state cost per tick and per
+// fired timer over simulated ticks, and lateness and cost from
+// a live run paced by sim::sleep_for at 1 ms per tick.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchWheel";
+
+namespace {
+
+constexpr std::size_t TIMERS = 10'000;
+constexpr timing::tick_t MIN_PERIOD = 10;
+constexpr timing::tick_t MAX_PERIOD = 1'000;
+constexpr std::size_t SIM_TICKS = 100'000;
+constexpr auto LIVE_RESOLUTION = std::chrono::milliseconds{ 1 };
+constexpr std::size_t LIVE_TICKS = 2'000;
+
+using Wheel = timing::TimerWheel<TIMERS>;
+
+timing::tick_t period_of(std::uint32_t i)
+{
+    // Deterministic spread over [MIN_PERIOD, MAX_PERIOD]
+    const std::uint32_t h = i * 2654435761u;
+    return MIN_PERIOD + (h >> 8) % (MAX_PERIOD - MIN_PERIOD + 1);
+}
+
+class HeapTimers {
+public:
+    explicit HeapTimers(std::size_t n) : generation_(n, 0), period_(n, 0)
+    {
+        std::vector<Entry> storage;
+        storage.reserve(2 * n);
+        heap_ = Heap{ std::greater<>{}, std::move(storage) };
+    }
+
+    void schedule(timing::tick_t delay, timing::tick_t period, std::uint32_t user)
+    {
+        period_[user] = period;
+        heap_.push({ now_ + delay, user, generation_[user] });
+    }
+
+    void cancel(std::uint32_t user) { ++generation_[user]; }
+
+    template <typename Fire>
+    std::size_t advance(timing::tick_t now, Fire&& fire)
+    {
+        now_ = now;
+        std::size_t fired = 0;
+        while (!heap_.empty() && heap_.top().expires <= now) {
+            Entry e = heap_.top();
+            heap_.pop();
+            if (e.generation != generation_[e.user]) {
+                continue;
+            }
+            ++fired;
+            fire(e.user);
+            e.expires += period_[e.user];
+            heap_.push(e);
+        }
+        return fired;
+    }
+
+private:
+    struct Entry {
+        timing::tick_t expires;
+        std::uint32_t user;
+        std::uint32_t generation;
+        bool operator>(const Entry& o) const { return expires > o.expires; }
+    };
+    using Heap = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>;
+
+    Heap heap_;
+    std::vector<std::uint32_t> generation_;
+    std::vector<timing::tick_t> period_;
+    timing::tick_t now_ = 0;
+};
+
+struct Cost {
+    double ns_per_tick;
+    double ns_per_fire;
+    std::size_t fired;
+};
+
+template <typename Timers>
+Cost run_ticks(Timers& timers, std::vector<std::uint32_t>& ticks, timing::tick_t from)
+{
+    std::size_t fired = 0;
+    const auto fire = [&ticks](std::uint32_t fsm) { ++ticks[fsm]; };
+    const double ns = bench::ns_per_op(SIM_TICKS, [&](std::size_t t) {
+        fired += timers.advance(from + t + 1, fire);
+    });
+    bench::do_not_optimize(ticks.data());
+    return { ns, ns * SIM_TICKS / static_cast<double>(fired), fired };
+}
+
+void measure_wheel(Wheel& wheel)
+{
+    std::vector<timing::TimerHandle> handles(TIMERS);
+    std::vector<std::uint32_t> ticks(TIMERS, 0);
+
+    const double schedule_ns = bench::ns_per_op(TIMERS, [&](std::size_t i) {
+        const auto fsm = static_cast<std::uint32_t>(i);
+        handles[i] = wheel.schedule(period_of(fsm), period_of(fsm), fsm);
+    });
+    const double cancel_ns = bench::ns_per_op(TIMERS, [&](std::size_t i) {
+        bench::do_not_optimize(wheel.cancel(handles[i]));
+    });
+
+    for (std::uint32_t fsm = 0; fsm < TIMERS; ++fsm) {
+        wheel.schedule(period_of(fsm), period_of(fsm), fsm);
+    }
+    wheel.reset_stats();
+    const Cost cost = run_ticks(wheel, ticks, wheel.now());
+    const auto stats = wheel.stats();
+
+    ESP_LOGI(TAG, "wheel  schedule %6.1f ns  cancel %6.1f ns  tick %7.1f ns  fire %6.1f ns  (%zu fired, max lateness %" PRIu64 ")",
+        schedule_ns, cancel_ns, cost.ns_per_tick, cost.ns_per_fire, cost.fired, stats.max_lateness);
+}
+
+void measure_heap()
+{
+    HeapTimers heap{ TIMERS };
+    std::vector<std::uint32_t> ticks(TIMERS, 0);
+
+    const double schedule_ns = bench::ns_per_op(TIMERS, [&](std::size_t i) {
+        const auto fsm = static_cast<std::uint32_t>(i);
+        heap.schedule(period_of(fsm), period_of(fsm), fsm);
+    });
+    const double cancel_ns = bench::ns_per_op(TIMERS, [&](std::size_t i) {
+        heap.cancel(static_cast<std::uint32_t>(i));
+    });
+
+    // Cancelled entries are popped lazily; flush them before timing
+    heap.advance(MAX_PERIOD, [](std::uint32_t) {});
+    for (std::uint32_t fsm = 0; fsm < TIMERS; ++fsm) {
+        heap.schedule(period_of(fsm), period_of(fsm), fsm);
+    }
+    const Cost cost = run_ticks(heap, ticks, MAX_PERIOD);
+
+    ESP_LOGI(TAG, "heap   schedule %6.1f ns  cancel %6.1f ns  tick %7.1f ns  fire %6.1f ns  (%zu fired)",
+        schedule_ns, cancel_ns, cost.ns_per_tick, cost.ns_per_fire, cost.fired);
+}
+
+// Same loop as timing::drive, bounded
+void measure_live(Wheel& wheel)
+{
+    std::vector<std::uint32_t> ticks(TIMERS, 0);
+    const auto fire = [&ticks](std::uint32_t fsm) { ++ticks[fsm]; };
+
+    wheel.reset_stats();
+    const timing::tick_t first = wheel.now();
+    const auto start = sim::now();
+    while (wheel.now() - first < LIVE_TICKS) {
+        const auto next = start + LIVE_RESOLUTION * static_cast<long>(wheel.now() - first + 1);
+        sim::sleep_for(next - sim::now());
+        wheel.advance(first + static_cast<timing::tick_t>((sim::now() - start) / LIVE_RESOLUTION), fire);
+    }
+    const auto s = wheel.stats();
+    ESP_LOGI(TAG, "live   %zu ticks of 1 ms: %" PRIu64 " fired in %" PRIu64 " advances, lateness max %" PRIu64 " mean %.2f ticks, "
+                  "advance max %" PRIu32 " %s, %.0f %s per fire",
+        LIVE_TICKS, s.fired, s.advances, s.max_lateness, s.mean_lateness, s.max_cost, cycles::unit,
+        s.mean_cost_per_fire, cycles::unit);
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    const auto wheel = bench::try_make<Wheel>(TAG, bench::Label{ "%zu timers", TIMERS });
+    if (!wheel) {
+        return;
+    }
+    ESP_LOGI(TAG, "%zu timers, periods %" PRIu64 "..%" PRIu64 " ticks, wheel %zu bytes",
+        TIMERS, MIN_PERIOD, MAX_PERIOD, sizeof(Wheel));
+    measure_wheel(*wheel);
+    measure_heap();
+    measure_live(*wheel);
+}
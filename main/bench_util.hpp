@@ -0,0 +1,89 @@
+// bench_util.hpp
+#pragma once
+
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <esp_log.h>
+
+//------------------------------------------------------------
+// Minimal helpers shared by the bench_*.cpp examples
+//------------------------------------------------------------
+namespace bench {
+
+// Keep the optimizer from discarding a value we only compute
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Force pending stores to be treated as observable
+inline void clobber()
+{
+    asm volatile("" : : : "memory");
+}
+
+// Average wall-clock nanoseconds per call of fn(i) over `iterations`
+template <typename F>
+[[nodiscard]] double ns_per_op(std::size_t iterations, F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+         / static_cast<double>(iterations);
+}
+
+// printf-formatted name of one bench point, e.g. Label{ "N=%6zu", n }
+class Label {
+public:
+    [[gnu::format(printf, 2, 3)]] explicit Label(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(text_, sizeof(text_), format, args);
+        va_end(args);
+    }
+
+    operator const char*() const { return text_; }
+
+private:
+    char text_[32];
+};
+
+// The largest bench points do not fit in on-chip RAM on every target.
+// try_make<T>() heap-allocates a default-initialised T (try_make<T[]>(..., n):
+// n of them) and returns nullptr after logging "<label>  skipped" instead
+// of aborting.
+template <typename T>
+    requires(!std::is_array_v<T>)
+[[nodiscard]] std::unique_ptr<T> try_make(const char* tag, const char* label)
+{
+    std::unique_ptr<T> p{ new (std::nothrow) T };
+    if (!p) {
+        ESP_LOGW(tag, "%s  skipped, %zu bytes do not fit", label, sizeof(T));
+    }
+    return p;
+}
+
+template <typename T>
+    requires std::is_unbounded_array_v<T>
+[[nodiscard]] std::unique_ptr<T> try_make(const char* tag, const char* label, std::size_t n)
+{
+    using E = std::remove_extent_t<T>;
+    std::unique_ptr<T> p{ new (std::nothrow) E[n] };
+    if (!p) {
+        ESP_LOGW(tag, "%s  skipped, %zu bytes do not fit", label, n * sizeof(E));
+    }
+    return p;
+}
+
+} // namespace bench
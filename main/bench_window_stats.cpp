@@ -0,0 +1,134 @@
+// bench_window_stats.cpp
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "running_ring.hpp"
+#include "simd_reduce.hpp"
+#include "window_stats.hpp"
+
+//------------------------------------------------------------
+// Window statistics per update: full scan vs. StatsWindow
+//
+// "scan" is what get_buffer_stats used to do after every push:
+// walk the ring once, then simd::minmax over both segments
+// (mean from the running sum). "window" is StatsWindow: push()
+// keeps min/max/sum current, stats() is a cached read. Both are
+// timed as push + read, then as a read with no new sample in
+// between (the dirty flag makes that a copy for StatsWindow,
+// the scan repeats in full). ns per operation.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchStats";
+
+namespace {
+
+// Noisy readings around a slow drift, so min/max actually change
+struct Samples {
+    float next()
+    {
+        state = state * 1664525u + 1013904223u;
+        phase += 1e-4f;
+        return 25.0f + 5.0f * (phase - static_cast<float>(static_cast<int>(phase)))
+            + static_cast<float>(state >> 8) * 0x1p-24f;
+    }
+    uint32_t state = 12345;
+    float phase = 0.0f;
+};
+
+template <std::size_t N>
+WindowStats<float> scan(const RunningRing<float, N>& ring)
+{
+    float visited = 0.0f;
+    for (auto view = ring.view(); const float v : view) {
+        visited = v; // the old no-op walk, kept so the cost compares like for like
+    }
+    bench::do_not_optimize(visited);
+    if (ring.empty()) {
+        return {};
+    }
+    const auto [older, newer] = ring.segments();
+    auto [lo, hi] = simd::minmax(older);
+    if (!newer.empty()) {
+        const auto [newer_lo, newer_hi] = simd::minmax(newer);
+        lo = std::min(lo, newer_lo);
+        hi = std::max(hi, newer_hi);
+    }
+    return { lo, hi, ring.mean(), ring.size() };
+}
+
+template <std::size_t N>
+void measure()
+{
+    // Fewer updates for big windows so the scan finishes in reasonable time
+    const std::size_t updates = std::max<std::size_t>(2 * N, (1u << 22) / N);
+    constexpr std::size_t window_updates = 1u << 22;
+    constexpr std::size_t reads = 1u << 20;
+
+    const bench::Label label{ "N=%6zu", N };
+    const auto ring = bench::try_make<RunningRing<float, N>>(TAG, label);
+    const auto window = bench::try_make<StatsWindow<float, N>>(TAG, label);
+    if (!ring || !window) {
+        return;
+    }
+
+    Samples scan_src;
+    float scan_acc = 0.0f;
+    const double scan_update_ns = bench::ns_per_op(updates, [&](std::size_t) {
+        ring->push(scan_src.next());
+        const WindowStats<float> s = scan(*ring);
+        scan_acc += s.max - s.min + s.mean;
+    });
+    const double scan_read_ns = bench::ns_per_op(std::max<std::size_t>(16, reads / N), [&](std::size_t) {
+        const WindowStats<float> s = scan(*ring);
+        scan_acc += s.max - s.min + s.mean;
+    });
+
+    Samples window_src;
+    float window_acc = 0.0f;
+    const double window_update_ns = bench::ns_per_op(window_updates, [&](std::size_t) {
+        window->push(window_src.next());
+        const WindowStats<float>& s = window->stats();
+        window_acc += s.max - s.min + s.mean;
+    });
+    const double window_read_ns = bench::ns_per_op(reads, [&](std::size_t) {
+        bench::clobber(); // keep the read inside the loop
+        const WindowStats<float>& s = window->stats();
+        window_acc += s.max - s.min + s.mean;
+    });
+
+    bench::do_not_optimize(scan_acc);
+    bench::do_not_optimize(window_acc);
+
+    // Same stream, same window: the answers must agree
+    Samples check_src;
+    const auto check = bench::try_make<RunningRing<float, N>>(TAG, label);
+    const auto check_window = bench::try_make<StatsWindow<float, N>>(TAG, label);
+    bool match = check && check_window;
+    for (std::size_t i = 0; match && i < 3 * N + 7; ++i) {
+        const float v = check_src.next();
+        check->push(v);
+        check_window->push(v);
+        const WindowStats<float> a = scan(*check);
+        const WindowStats<float>& b = check_window->stats();
+        match = a.min == b.min && a.max == b.max && a.count == b.count;
+    }
+
+    ESP_LOGI(TAG, "N=%6zu  update: scan %10.2f  window %5.2f  |  read: scan %10.2f  window %5.2f ns  |  %s",
+        N, scan_update_ns, window_update_ns, scan_read_ns, window_read_ns, match ? "match" : "MISMATCH");
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    measure<8>();
+    measure<64>();
+    measure<512>();
+    measure<4096>();
+    measure<32768>();
+    measure<65536>();
+}
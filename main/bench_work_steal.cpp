@@ -0,0 +1,124 @@
+// bench_work_steal.cpp
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <freertos/FreeRTOS.h>
+#include <esp_log.h>
+
+#include "bench_util.hpp"
+#include "channel_store.hpp"
+#include "sim_sensors.hpp"
+#include "window_stats.hpp"
+#include "work_steal.hpp"
+
+//------------------------------------------------------------
+// One update cycle over N managers: serial vs. exec::Executor
+//
+// Each manager does what StateMachineManager::update does minus
+// the logging: three simulated sensor reads, a StatsWindow push,
+// a ChannelStore row and a stats read. "serial" is the old loop
+// on one task; the executor runs the same cycle with 2-16
+// workers pinned round-robin (to both cores on target, to every
+// host CPU on host). Reported as us per cycle, speedup over
+// serial and ranges stolen per cycle.
+//------------------------------------------------------------
+static constexpr const char* TAG = "BenchSteal";
+
+namespace {
+
+#if __has_include(<sdkconfig.h>)
+const int CORES = portNUM_PROCESSORS;
+#else
+const int CORES = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+
+constexpr std::size_t WORK_PER_POINT = 400'000; // manager updates per measurement
+
+class Manager {
+public:
+    Manager() : temp_{ 1, 23.5f, 1.0f, 7 }, humidity_{ 2, 45.0f, 2.0f, 8 }, pressure_{ 3, 1013.25f, 5.0f, 9 }
+    {
+        for (int id = 1; id <= 3; ++id) {
+            history_.bind(id);
+        }
+    }
+
+    void update()
+    {
+        const std::array<float, 3> row{ temp_.read(), humidity_.read(), pressure_.read() };
+        window_.push(row[0]);
+        history_.push(row);
+        checksum_ += window_.stats().mean + history_.stats(1).max;
+        ++updates_;
+    }
+
+    [[nodiscard]] std::uint32_t updates() const { return updates_; }
+    [[nodiscard]] float checksum() const { return checksum_; }
+
+private:
+    sim::NoiseSensor temp_;
+    sim::NoiseSensor humidity_;
+    sim::NoiseSensor pressure_;
+    StatsWindow<float, 10> window_;
+    ChannelStore<float, 4, 32> history_;
+    std::uint32_t updates_ = 0;
+    float checksum_ = 0.0f;
+};
+
+double us_per_cycle(exec::Executor& executor, Manager* managers, std::size_t n, std::size_t cycles)
+{
+    const double ns = bench::ns_per_op(cycles, [&](std::size_t) {
+        executor.parallel_for(n, 1, [managers](std::size_t i) { managers[i].update(); });
+    });
+    return ns / 1000.0;
+}
+
+void measure(std::size_t n)
+{
+    const auto managers = bench::try_make<Manager[]>(TAG, bench::Label{ "managers=%5zu", n }, n);
+    if (!managers) {
+        return;
+    }
+    const std::size_t cycles = std::max<std::size_t>(10, WORK_PER_POINT / n);
+
+    exec::Executor serial{ { .workers = 0 } };
+    const double serial_us = us_per_cycle(serial, managers.get(), n, cycles);
+    ESP_LOGI(TAG, "managers=%5zu  serial     %9.1f us/cycle", n, serial_us);
+
+    std::size_t expected = cycles;
+    for (const std::size_t workers : { 2u, 4u, 8u, 16u }) {
+        exec::Executor executor{ { .workers = workers, .cores = CORES, .name = "BenchWorker" } };
+        const double us = us_per_cycle(executor, managers.get(), n, cycles);
+        expected += cycles;
+        const auto stats = executor.stats();
+        ESP_LOGI(TAG, "managers=%5zu  workers=%2zu %9.1f us/cycle  %5.2fx  %6.1f steals/cycle",
+            n, workers, us, serial_us / us, static_cast<double>(stats.steals) / static_cast<double>(cycles));
+    }
+
+    // Every manager updated exactly once per cycle
+    std::size_t wrong = 0;
+    float checksum = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        wrong += managers[i].updates() != expected;
+        checksum += managers[i].checksum();
+    }
+    bench::do_not_optimize(checksum);
+    if (wrong != 0) {
+        ESP_LOGE(TAG, "managers=%5zu  %zu managers missed or repeated updates", n, wrong);
+    }
+}
+
+} // namespace
+
+extern "C" void app_main()
+{
+    ESP_LOGI(TAG, "%d core(s) to pin to, %zu bytes per manager", CORES, sizeof(Manager));
+    for (const std::size_t n : { 10u, 100u, 1000u, 10000u }) {
+        measure(n);
+    }
+}
@@ -0,0 +1,186 @@
+// binlog.hpp
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_log.h>
+
+#include "cycles.hpp"
+#include "mpsc_queue.hpp"
+#include "sim_clock.hpp"
+
+//------------------------------------------------------------
+// Deferred binary logging
+//
+// BINLOGI(tag, fmt, args...) does no formatting and no I/O: it
+// copies a pointer to the call site's static format string, the
+// tag pointer, a cycles::now() stamp and the raw argument bytes into a
+// lock-free queue for the current core. binlog::drain() (run from
+// a low-priority task, see drain_task) decodes the records back
+// into text and prints them through ESP_LOG.
+//
+// Arguments must be arithmetic, enums or pointers, ARG_BYTES in
+// total. Pointers are stored as-is, so %s arguments must outlive
+// the drain: literals, task names, other static strings. When a
+// queue is full the record is dropped and counted, never blocked
+// on. Records are ordered per core, not across cores.
+//------------------------------------------------------------
+namespace binlog {
+
+enum class Level : std::uint8_t { error, warn, info };
+
+// One per call site, lives in flash; its address is the format ID
+struct Site {
+    Level level;
+    const char* fmt;
+};
+
+inline constexpr std::size_t ARG_BYTES = 32;
+inline constexpr std::size_t QUEUE_CAPACITY = 64;
+
+struct Record;
+using decode_fn = int (*)(const Record&, std::span<char>);
+
+struct Record {
+    const Site* site;
+    decode_fn decode;   // typed unpacker for the argument bytes
+    const char* tag;
+    std::uint32_t cycles;
+    std::array<std::byte, ARG_BYTES> args;
+};
+
+using Queue = lockfree::MpscQueue<Record, QUEUE_CAPACITY, lockfree::untimed_clock>;
+
+inline std::array<Queue, portNUM_PROCESSORS> queues;
+
+namespace detail {
+
+template <typename T>
+concept loggable = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// What a record keeps of an argument: literals become const char*
+template <typename T>
+using stored_t = std::decay_t<const T>;
+
+template <typename... Args>
+int decode(const Record& r, std::span<char> out)
+{
+    std::tuple<Args...> args;
+    std::size_t offset = 0;
+    std::apply([&](auto&... a) {
+        ((std::memcpy(&a, r.args.data() + offset, sizeof a), offset += sizeof a), ...);
+    }, args);
+    return std::apply([&](const auto&... a) {
+        return std::snprintf(out.data(), out.size(), r.site->fmt, a...);
+    }, args);
+}
+
+} // namespace detail
+
+// Hot path: a few stores and one queue push. Returns false on drop.
+template <typename... Args>
+    requires (detail::loggable<detail::stored_t<Args>> && ...)
+bool write(const Site& site, const char* tag, const Args&... args)
+{
+    static_assert((sizeof(detail::stored_t<Args>) + ... + 0) <= ARG_BYTES, "too many log arguments for one record");
+
+    Record r;
+    r.site = &site;
+    r.decode = &detail::decode<detail::stored_t<Args>...>;
+    r.tag = tag;
+    r.cycles = cycles::now();
+    std::size_t offset = 0;
+    ([&](const detail::stored_t<Args> value) {
+        std::memcpy(r.args.data() + offset, &value, sizeof value);
+        offset += sizeof value;
+    }(args), ...);
+    return queues[xPortGetCoreID()].try_push(r);
+}
+
+// Formats one record into out (truncating); returns the snprintf result
+inline int format(const Record& r, std::span<char> out)
+{
+    return r.decode(r, out);
+}
+
+inline void print(const Record& r)
+{
+    std::array<char, 128> line;
+    format(r, line);
+    switch (r.site->level) {
+    case Level::error:
+        ESP_LOGE(r.tag, "[%" PRIu32 "] %s", r.cycles, line.data());
+        break;
+    case Level::warn:
+        ESP_LOGW(r.tag, "[%" PRIu32 "] %s", r.cycles, line.data());
+        break;
+    case Level::info:
+        ESP_LOGI(r.tag, "[%" PRIu32 "] %s", r.cycles, line.data());
+        break;
+    }
+}
+
+// Consumer side (one task only): hands every queued record to sink
+template <typename Sink>
+std::size_t drain(Sink&& sink, std::size_t max_per_core = QUEUE_CAPACITY)
+{
+    std::size_t n = 0;
+    for (auto& q : queues) {
+        n += q.drain(sink, max_per_core);
+    }
+    return n;
+}
+
+inline std::size_t drain()
+{
+    return drain([](const Record& r) { print(r); });
+}
+
+// Records lost because a queue was full, summed over cores
+inline std::uint32_t drops()
+{
+    std::uint32_t n = 0;
+    for (const auto& q : queues) {
+        n += q.stats().drops;
+    }
+    return n;
+}
+
+// Body for a low-priority std::jthread (wrap with sim::task)
+inline void drain_task(std::stop_token stop, std::chrono::milliseconds period)
+{
+    while (!stop.stop_requested()) {
+        drain();
+        sim::sleep_for(period);
+    }
+    drain();
+}
+
+} // namespace binlog
+
+// The dead printf lets the compiler check fmt against the arguments
+#define BINLOG_AT(level, tag, fmt, ...)                                              \
+    do {                                                                             \
+        static constexpr ::binlog::Site binlog_site_{ level, fmt };                  \
+        if (false) {                                                                 \
+            std::printf(fmt __VA_OPT__(,) __VA_ARGS__);                              \
+        }                                                                            \
+        ::binlog::write(binlog_site_, tag __VA_OPT__(,) __VA_ARGS__);                \
+    } while (0)
+
+#define BINLOGE(tag, fmt, ...) BINLOG_AT(::binlog::Level::error, tag, fmt __VA_OPT__(,) __VA_ARGS__)
+#define BINLOGW(tag, fmt, ...) BINLOG_AT(::binlog::Level::warn, tag, fmt __VA_OPT__(,) __VA_ARGS__)
+#define BINLOGI(tag, fmt, ...) BINLOG_AT(::binlog::Level::info, tag, fmt __VA_OPT__(,) __VA_ARGS__)
@@ -0,0 +1,18 @@
+// cache_line.hpp
+#pragma once
+
+#include <cstddef>
+
+//------------------------------------------------------------
+// Alignment used to keep independently written atomics apart
+//
+// 64 covers host CPUs and the ESP32-S3 data cache's largest
+// line setting; on parts with 32-byte lines it only wastes a
+// little padding. Shared by the lockfree:: containers.
+//------------------------------------------------------------
+namespace lockfree {
+
+// Keeps producer and consumer indices from false sharing
+inline constexpr std::size_t cache_line_size = 64;
+
+} // namespace lockfree
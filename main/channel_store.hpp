@@ -0,0 +1,127 @@
+// channel_store.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <span>
+
+#include "simd_reduce.hpp"
+#include "window_stats.hpp"
+
+//------------------------------------------------------------
+// History of the last Depth rows of up to Channels sensors
+//
+// Structure of arrays: one contiguous column per channel, all
+// sharing a single write cursor, so push() is one store per
+// channel and a column is a zero-copy span (two once the cursor
+// has wrapped, oldest first). Channels are claimed by sensor id
+// on first bind(). stats(ch) runs the simd_reduce.hpp kernels
+// over the column on demand and caches the result until the
+// next row; nothing is allocated after construction. T must be
+// int or float (the reduction kernels' types).
+//------------------------------------------------------------
+template <typename T, std::size_t Channels, std::size_t Depth>
+class ChannelStore {
+    static_assert(Channels > 0 && Depth > 0);
+
+public:
+    static constexpr std::size_t npos = Channels;
+
+    // Column for `id`, claiming a free one the first time; npos when all are taken
+    std::size_t bind(int id)
+    {
+        for (std::size_t ch = 0; ch < bound_; ++ch) {
+            if (ids_[ch] == id) {
+                return ch;
+            }
+        }
+        if (bound_ == Channels) {
+            return npos;
+        }
+        ids_[bound_] = id;
+        return bound_++;
+    }
+
+    // Column already bound to `id`, or npos
+    [[nodiscard]] std::size_t channel(int id) const
+    {
+        for (std::size_t ch = 0; ch < bound_; ++ch) {
+            if (ids_[ch] == id) {
+                return ch;
+            }
+        }
+        return npos;
+    }
+
+    // One sample per column in column order; missing columns get T{}
+    void push(std::span<const T> row)
+    {
+        const std::size_t given = std::min(row.size(), Channels);
+        for (std::size_t ch = 0; ch < given; ++ch) {
+            columns_[ch][head_] = row[ch];
+        }
+        for (std::size_t ch = given; ch < Channels; ++ch) {
+            columns_[ch][head_] = T{};
+        }
+        head_ = head_ + 1 == Depth ? 0 : head_ + 1;
+        size_ += size_ < Depth;
+        fresh_.reset();
+    }
+
+    // Oldest run first; the second span is empty until the cursor wraps
+    [[nodiscard]] std::array<std::span<const T>, 2> column(std::size_t ch) const
+    {
+        const std::size_t start = size_ == Depth ? head_ : 0;
+        const std::size_t first = std::min(size_, Depth - start);
+        return { std::span<const T>{ columns_[ch].data() + start, first },
+                 std::span<const T>{ columns_[ch].data(), size_ - first } };
+    }
+
+    // Only meaningful when !empty()
+    [[nodiscard]] T latest(std::size_t ch) const { return columns_[ch][(head_ == 0 ? Depth : head_) - 1]; }
+
+    // All zero while empty
+    [[nodiscard]] const WindowStats<T>& stats(std::size_t ch) const
+    {
+        if (!fresh_[ch]) {
+            cached_[ch] = reduce(ch);
+            fresh_.set(ch);
+        }
+        return cached_[ch];
+    }
+
+    [[nodiscard]] int id(std::size_t ch) const { return ids_[ch]; }
+    [[nodiscard]] std::size_t channels() const { return bound_; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    static constexpr std::size_t capacity() { return Depth; }
+
+private:
+    WindowStats<T> reduce(std::size_t ch) const
+    {
+        if (size_ == 0) {
+            return {};
+        }
+        const auto [older, newer] = column(ch);
+        auto [lo, hi] = simd::minmax(older);
+        auto sum = simd::sum(older);
+        if (!newer.empty()) {
+            const auto [newer_lo, newer_hi] = simd::minmax(newer);
+            lo = std::min(lo, newer_lo);
+            hi = std::max(hi, newer_hi);
+            sum += simd::sum(newer);
+        }
+        return { lo, hi, static_cast<T>(sum / static_cast<decltype(sum)>(size_)), size_ };
+    }
+
+    std::array<std::array<T, Depth>, Channels> columns_{};
+    std::array<int, Channels> ids_{};
+    std::size_t bound_ = 0;
+    std::size_t head_ = 0; // next row to write
+    std::size_t size_ = 0;
+    mutable std::array<WindowStats<T>, Channels> cached_{};
+    mutable std::bitset<Channels> fresh_;
+};
@@ -2,30 +2,31 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
-#include <string>
-#include <format>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <esp_log.h>
 #include <esp_pthread.h>
 
+#include "binlog.hpp"
+#include "sim_clock.hpp"
+
 // --- C++23 Goodies ---
 using namespace std::chrono_literals;
 constexpr auto sleep_duration = 5s;
+constexpr auto log_drain_period = 500ms;
 
-// Helper to reliably log formatted string using ESP_LOGI
-auto print_thread_info(const char *task_name, const std::string_view extra = "") -> void
+// Records a binary log entry; the "binlog" drain task formats it later.
+// extra must be a literal (the pointer is stored, not the text).
+auto print_thread_info(const char *task_name, const char *extra = nullptr) -> void
 {
-    // C++23: Uses std::format for cleaner string creation than stringstream
-    const std::string log_message = std::format(
-        "{}{}Core id: {}, prio: {}, min free stack: {} bytes.",
-        extra,
-        !extra.empty() ? " " : "", // Add space if extra is present
-        xPortGetCoreID(),
-        uxTaskPriorityGet(nullptr),
-        uxTaskGetStackHighWaterMark(nullptr)
-    );
-    ESP_LOGI(task_name, "%s", log_message.c_str());
+    const auto core = static_cast<int>(xPortGetCoreID());
+    const auto prio = static_cast<unsigned>(uxTaskPriorityGet(nullptr));
+    const auto stack = static_cast<unsigned>(uxTaskGetStackHighWaterMark(nullptr));
+    if (extra != nullptr) {
+        BINLOGI(task_name, "%s Core id: %d, prio: %u, min free stack: %u bytes.", extra, core, prio, stack);
+    } else {
+        BINLOGI(task_name, "Core id: %d, prio: %u, min free stack: %u bytes.", core, prio, stack);
+    }
 }
 
 // --- Thread Functions ---
@@ -35,7 +36,7 @@ auto thread_func_inherited() -> void
     const char* const name = pcTaskGetName(nullptr);
     while (true) {
         print_thread_info(name, "INHERITING thread (same params/name as parent).");
-        std::this_thread::sleep_for(sleep_duration);
+        sim::sleep_for(sleep_duration);
     }
 }
 
@@ -44,12 +45,12 @@ auto spawn_another_thread() -> void
     const char* const name = pcTaskGetName(nullptr);
     
     // C++11/14/17: Still using std::jthread, detached for embedded infinite loop
-    std::jthread inherits(thread_func_inherited);
+    std::jthread inherits(sim::task(thread_func_inherited));
     inherits.detach();
 
     while (true) {
         print_thread_info(name);
-        std::this_thread::sleep_for(sleep_duration);
+        sim::sleep_for(sleep_duration);
     }
 }
 
@@ -58,7 +59,7 @@ auto thread_func_any_core() -> void
     const char* const name = pcTaskGetName(nullptr);
     while (true) {
         print_thread_info(name, "ANY_CORE thread (default config).");
-        std::this_thread::sleep_for(sleep_duration);
+        sim::sleep_for(sleep_duration);
     }
 }
 
@@ -67,7 +68,7 @@ auto thread_func() -> void
     const char* const name = pcTaskGetName(nullptr);
     while (true) {
         print_thread_info(name);
-        std::this_thread::sleep_for(sleep_duration);
+        sim::sleep_for(sleep_duration);
     }
 }
 
@@ -93,7 +94,7 @@ extern "C" void app_main(void)
     []() {
         const auto cfg = esp_pthread_get_default_config();
         esp_pthread_set_cfg(&cfg);
-        std::jthread any_core(thread_func_any_core);
+        std::jthread any_core(sim::task(thread_func_any_core));
         any_core.detach();
     }(); // IILE (Immediately Invoked Lambda Expression) C++11+
 
@@ -107,7 +108,7 @@ extern "C" void app_main(void)
             true // Inherit config
         );
         esp_pthread_set_cfg(&cfg);
-        std::jthread thread_1(spawn_another_thread);
+        std::jthread thread_1(sim::task(spawn_another_thread));
         thread_1.detach();
     }();
 
@@ -120,14 +121,27 @@ extern "C" void app_main(void)
             5
         );
         esp_pthread_set_cfg(&cfg);
-        std::jthread thread_2(thread_func);
+        std::jthread thread_2(sim::task(thread_func));
         thread_2.detach();
     }();
     
-    // 4. Main Task Loop
+    // 4. Log drain: lowest priority, any core
+    []() {
+        const auto cfg = create_config(
+            "binlog",
+            tskNO_AFFINITY,
+            3 * 1024,
+            1
+        );
+        esp_pthread_set_cfg(&cfg);
+        std::jthread log_drain(sim::task(binlog::drain_task), std::chrono::milliseconds{ log_drain_period });
+        log_drain.detach();
+    }();
+
+    // 5. Main Task Loop
     const char* const main_task_name = pcTaskGetName(nullptr);
     while (true) {
         print_thread_info(main_task_name, "MAIN_TASK is running.");
-        std::this_thread::sleep_for(sleep_duration);
+        sim::sleep_for(sleep_duration);
     }
 }
\ No newline at end of file
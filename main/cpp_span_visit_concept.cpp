@@ -3,9 +3,11 @@
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <memory>
 #include <array>
 #include <span>
 #include <variant>
+#include <tuple>
 #include <string>
 #include <format>
 #include <optional>
@@ -15,6 +17,18 @@
 #include <esp_log.h>
 #include <esp_pthread.h>
 
+#include "fsm_flow.hpp"
+#include "fsm_profile.hpp"
+#include "log_gate.hpp"
+#include "seqlock.hpp"
+#include "sim_clock.hpp"
+#include "alloc_count.hpp"
+#include "channel_store.hpp"
+#include "sensor_registry.hpp"
+#include "sim_sensors.hpp"
+#include "window_stats.hpp"
+#include "work_steal.hpp"
+
 // --- C++23 Feature Test Macros ---
 #ifdef __has_include
 #  if __has_include(<version>)
@@ -29,14 +43,20 @@
 using namespace std::chrono_literals;
 constexpr auto STATE_UPDATE_INTERVAL = 2s;
 constexpr auto LOG_INTERVAL = 5s;
+constexpr int PROFILE_DUMP_EVERY = 6; // main loop cycles, ~30 s
+constexpr int ARENA_REPORT_EVERY = 6;
+constexpr size_t SENSOR_BLOCK = 32; // samples per read_into() call
+constexpr size_t SENSOR_WINDOW = 10; // updates averaged while monitoring, one block mean each
+constexpr size_t SENSOR_CHANNELS = 4; // sensors with a history column
+constexpr size_t SENSOR_HISTORY = 32; // latest readings kept per sensor
+constexpr size_t SENSOR_SET_BYTES = 256; // one FIFO sensor (192) + two scalar ones (28)
+constexpr size_t STATE_INFO_SIZE = 96; // bytes for one state description
+constexpr uint32_t PROCESSOR_MANAGERS = 3;
+// One worker per core; none under virtual time, where tasks may only block in sim::sleep_for
+constexpr size_t PROCESSOR_WORKERS = SIM_VIRTUAL_TIME ? 0 : portNUM_PROCESSORS;
 
 // --- Concepts & Constraints ---
-template<typename T>
-concept SensorType = requires(T t) {
-    { t.read() } -> std::convertible_to<float>;
-    { t.get_id() } -> std::convertible_to<int>;
-};
-
+// SensorType / BlockSensorType: sensor_registry.hpp
 template<typename T>
 concept StateType = requires {
     requires std::is_enum_v<T> || std::is_class_v<T>;
@@ -56,6 +76,7 @@ struct AlertState {
 struct CalibratingState {
     float reference_value;
     int calibration_step;
+    fsm::Flow<float> procedure; // one resume per sensor update
 };
 
 using StateVariant = std::variant<
@@ -66,78 +87,118 @@ using StateVariant = std::variant<
 >;
 
 // --- Sensor Concepts Implementation ---
-class TemperatureSensor {
+// Per-instance xoshiro streams: no shared rand() state across tasks
+class TemperatureSensor : public sim::FifoNoiseSensor {
 public:
-    auto read() const -> float { return 23.5f + (rand() % 100) * 0.01f; }
-    auto get_id() const -> int { return 1; }
+    explicit TemperatureSensor(uint32_t seed) : FifoNoiseSensor{1, 23.5f, 1.0f, seed, SENSOR_BLOCK} {}
 };
 
-class HumiditySensor {
+class HumiditySensor : public sim::ScalarNoiseSensor {
 public:
-    auto read() const -> float { return 45.0f + (rand() % 100) * 0.02f; }
-    auto get_id() const -> int { return 2; }
+    explicit HumiditySensor(uint32_t seed) : ScalarNoiseSensor{2, 45.0f, 2.0f, seed} {}
 };
 
-class PressureSensor {
+class PressureSensor : public sim::ScalarNoiseSensor {
 public:
-    auto read() const -> float { return 1013.25f + (rand() % 100) * 0.05f; }
-    auto get_id() const -> int { return 3; }
+    explicit PressureSensor(uint32_t seed) : ScalarNoiseSensor{3, 1013.25f, 5.0f, seed} {}
 };
 
+static_assert(BlockSensorType<TemperatureSensor> && !BlockSensorType<HumiditySensor>);
+
+// --- Coroutine Flows ---
+constexpr float CALIBRATION_REFERENCE = 22.5f;
+constexpr int CALIBRATION_STEPS = 5;
+
+// Averages the offset from the reference over five updates; the
+// frame lives in the fsm_flow.hpp arena, not on the heap
+fsm::Flow<float> calibrate(float reference) {
+    float offset = 0.0f;
+    for (int step = 1; step <= CALIBRATION_STEPS; ++step) {
+        const float reading = co_await fsm::next_tick();
+        offset += reading - reference;
+        ESP_LOGD("Calibration", "Step %d/%d: reading %.2f", step, CALIBRATION_STEPS, reading);
+    }
+    ESP_LOGI("Calibration", "Done, offset %.2f", offset / CALIBRATION_STEPS);
+}
+
 // --- State Machine with Variants & Visit ---
 class StateMachine {
 private:
     StateVariant current_state_{IdleState{}};
     StateId current_id_{StateId::IDLE};
-    std::array<float, 10> sensor_buffer_{};
-    size_t buffer_index_{0};
+    StatsWindow<float, SENSOR_WINDOW> sensor_buffer_;
+    ChannelStore<float, SENSOR_CHANNELS, SENSOR_HISTORY> history_;
+    uint32_t samples_ingested_ = 0;
 
 public:
-    // --- Public accessor for buffer index ---
-    [[nodiscard]] auto get_buffer_index() const -> size_t {
-        return buffer_index_;
+    using SensorHistory = decltype(history_);
+
+    // --- Public accessor for buffer fill ---
+    [[nodiscard]] auto get_buffer_size() const -> size_t {
+        return sensor_buffer_.size();
     }
 
     // --- Abbreviated Function Templates (C++20) ---
     auto transition_to(StateVariant new_state) -> void {
-        current_state_ = new_state;
+        current_state_ = std::move(new_state);
         current_id_ = static_cast<StateId>(current_state_.index());
     }
 
     // --- Using std::visit with variants ---
-    auto get_state_info() const -> std::string {
-        return std::visit([]<typename T>(const T& state) -> std::string {
+    // Formats into the caller's buffer (truncating, always NUL-terminated)
+    auto describe_state(std::span<char> out) const -> const char* {
+        const size_t limit = out.size() - 1;
+        char* const end = std::visit([&]<typename T>(const T& state) -> char* {
             if constexpr (std::is_same_v<T, IdleState>) {
-                return "Idle - Waiting for commands";
+                return std::format_to_n(out.data(), limit, "Idle - Waiting for commands").out;
             } else if constexpr (std::is_same_v<T, MonitoringState>) {
-                return std::format("Monitoring - Avg: {:.2f}, Samples: {}",
-                    state.average_value, state.sample_count);
+                return std::format_to_n(out.data(), limit, "Monitoring - Avg: {:.2f}, Samples: {}",
+                    state.average_value, state.sample_count).out;
             } else if constexpr (std::is_same_v<T, AlertState>) {
-                return std::format("ALERT: {} (Threshold: {:.1f})",
-                    state.message, state.threshold);
+                return std::format_to_n(out.data(), limit, "ALERT: {} (Threshold: {:.1f})",
+                    state.message, state.threshold).out;
             } else if constexpr (std::is_same_v<T, CalibratingState>) {
-                return std::format("Calibrating - Ref: {:.2f}, Step: {}",
-                    state.reference_value, state.calibration_step);
+                return std::format_to_n(out.data(), limit, "Calibrating - Ref: {:.2f}, Step: {}",
+                    state.reference_value, state.calibration_step).out;
             }
         }, current_state_);
+        *end = '\0';
+        return out.data();
     }
 
     // --- Process sensors using span ---
     template<SensorType... Sensors>
     auto process_sensors(Sensors&&... sensors) -> void {
-        // Create span of sensor readings
-        std::array<float, sizeof...(sensors)> readings{sensors.read()...};
-        std::span<const float> readings_span{readings};
-        
-        // Update buffer with first reading
-        if (!readings_span.empty()) {
-            sensor_buffer_[buffer_index_ % sensor_buffer_.size()] = readings_span[0];
-            buffer_index_++;
+        // Latest reading per sensor; the first one also feeds the buffer
+        size_t position = 0;
+        std::array<float, sizeof...(sensors)> readings{latest(sensors, position++ == 0)...};
+        record(readings, std::array{sensors.get_id()...});
+        step(readings);
+    }
+
+    // Same, for a sensor set chosen at run time
+    template<size_t N, size_t Block, size_t Slot>
+    auto process_sensors(sensors::SensorRegistry<N, Block, Slot>& registry) -> void {
+        std::array<float, N> readings;
+        const size_t n = registry.poll(readings, [this](size_t i, std::span<const float> samples) {
+            if (i == 0) {
+                ingest(samples);
+            }
+        });
+        std::array<int, N> ids;
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = registry.id(i);
         }
+        record(std::span<const float>{readings}.first(n), std::span<const int>{ids}.first(n));
+        step(std::span<const float>{readings}.first(n));
+    }
 
-        // State transition logic
+private:
+    // --- State transition logic ---
+    auto step(std::span<const float> readings_span) -> void {
         std::visit([this, readings_span](auto& state) {
             using T = std::decay_t<decltype(state)>;
+            FSM_PROFILE_SCOPE(profile::type_name<T>(), "process_sensors");
             
             if constexpr (std::is_same_v<T, IdleState>) {
                 if (!readings_span.empty() && readings_span[0] > 20.0f) {
@@ -146,108 +207,210 @@ public:
             } else if constexpr (std::is_same_v<T, MonitoringState>) {
                 state.sample_count++;
                 
-                // Calculate average using span
-                float sum = 0;
-                for (auto val : sensor_buffer_ | std::views::take(buffer_index_)) {
-                    sum += val;
-                }
-                state.average_value = sum / std::min(buffer_index_, sensor_buffer_.size());
+                // Running mean, O(1) whatever the window size
+                state.average_value = sensor_buffer_.stats().mean;
                 
                 if (state.average_value > 30.0f) {
                     transition_to(AlertState{"Temperature High", 30.0f});
                 }
             } else if constexpr (std::is_same_v<T, AlertState>) {
                 if (!readings_span.empty() && readings_span[0] < 25.0f) {
-                    transition_to(CalibratingState{22.5f, 1});
+                    transition_to(CalibratingState{CALIBRATION_REFERENCE, 0, calibrate(CALIBRATION_REFERENCE)});
                 }
             } else if constexpr (std::is_same_v<T, CalibratingState>) {
                 state.calibration_step++;
-                if (state.calibration_step > 5) {
+                if (!state.procedure.resume(readings_span.empty() ? state.reference_value : readings_span[0])) {
                     transition_to(IdleState{});
                 }
             }
         }, current_state_);
     }
 
-    // --- Get buffer statistics using span ---
-    auto get_buffer_stats() const -> std::tuple<float, float> {
-        // Range-for with init (C++20)
-        for (std::span<const float> data{sensor_buffer_.data(), 
-             std::min(buffer_index_, sensor_buffer_.size())}; 
-             auto val : data) {
-            [[maybe_unused]] auto _ = val; // Example of [[maybe_unused]]
+    // --- Sensor ingest: whole blocks when the sensor supports them ---
+    template<SensorType S>
+    auto latest(S& sensor, bool buffered) -> float {
+        if constexpr (BlockSensorType<S>) {
+            std::array<float, SENSOR_BLOCK> block;
+            const size_t count = std::min<size_t>(sensor.read_into(block), block.size());
+            if (count != 0) {
+                if (buffered) {
+                    ingest(std::span<const float>{block}.first(count));
+                }
+                return block[count - 1];
+            }
+            // FIFO empty: poll once, as for a plain sensor
         }
-        
-        if (buffer_index_ == 0) return {0.0f, 0.0f};
-        
-        std::span<const float> active_buffer{
-            sensor_buffer_.data(), 
-            std::min(buffer_index_, sensor_buffer_.size())
-        };
-        
-        float min_val = std::numeric_limits<float>::max();
-        float max_val = std::numeric_limits<float>::lowest();
-        
-        for (auto val : active_buffer) {
-            min_val = std::min(min_val, val);
-            max_val = std::max(max_val, val);
+        const float value = sensor.read();
+        if (buffered) {
+            ingest(std::span{&value, 1});
         }
-        
-        return {min_val, max_val};
+        return value;
+    }
+
+    // One window entry per update, so SENSOR_WINDOW spans the same time
+    // whether a sensor hands over a FIFO block or a single reading
+    auto ingest(std::span<const float> samples) -> void {
+        float sum = 0.0f;
+        for (const float v : samples) {
+            sum += v;
+        }
+        sensor_buffer_.push(sum / static_cast<float>(samples.size()));
+        samples_ingested_ += static_cast<uint32_t>(samples.size());
+    }
+
+    // One history row per update, every reading in its sensor's column
+    auto record(std::span<const float> readings, std::span<const int> ids) -> void {
+        std::array<float, SENSOR_CHANNELS> row{};
+        for (size_t i = 0; i < readings.size(); ++i) {
+            if (const size_t ch = history_.bind(ids[i]); ch != SensorHistory::npos) {
+                row[ch] = readings[i];
+            }
+        }
+        history_.push(std::span<const float>{row}.first(history_.channels()));
+    }
+
+public:
+    // --- Buffer statistics, maintained on ingest: O(1) to read ---
+    auto get_buffer_stats() const -> const WindowStats<float>& {
+        return sensor_buffer_.stats();
     }
 
+    // --- Per-sensor history: zero-copy columns, cached stats ---
+    [[nodiscard]] auto get_history() const -> const SensorHistory& { return history_; }
+
     auto get_current_state_id() const -> StateId { return current_id_; }
+    auto get_samples_ingested() const -> uint32_t { return samples_ingested_; }
+};
+
+// What other tasks may read about a manager while it runs
+struct ManagerSnapshot {
+    StateId state;
+    uint32_t samples; // readings ingested so far
+    WindowStats<float> buffer;
 };
 
+// --- Sensor sets ---
+// Fixed at compile time: polled through the variadic process_sensors
+using FixedSensors = std::tuple<TemperatureSensor, HumiditySensor, PressureSensor>;
+// Picked at run time: polled through a registry, inline, no heap
+using SensorSet = sensors::SensorRegistry<SENSOR_CHANNELS, SENSOR_SET_BYTES, SENSOR_BLOCK>;
+
+// Same seed, same sensor streams on every run; the first sensor feeds the buffer
+auto make_fixed_sensors(uint32_t seed) -> FixedSensors {
+    return {TemperatureSensor{seed * 3}, HumiditySensor{seed * 3 + 1}, PressureSensor{seed * 3 + 2}};
+}
+
+auto make_sensor_set(uint32_t seed, bool with_pressure) -> SensorSet {
+    SensorSet set;
+    set.add<TemperatureSensor>(seed * 3);
+    set.add<HumiditySensor>(seed * 3 + 1);
+    if (with_pressure) {
+        set.add<PressureSensor>(seed * 3 + 2);
+    }
+    return set;
+}
+
 // --- Thread-safe State Machine Manager ---
+// update() belongs to one task; snapshot() and get_state_id() may be called
+// from any task on either core, without locks
+template<typename Sensors>
 class StateMachineManager {
 private:
+    static constexpr const char* TAG = "StateMachine";
+
     StateMachine state_machine_;
-    TemperatureSensor temp_sensor_;
-    HumiditySensor humidity_sensor_;
-    PressureSensor pressure_sensor_;
+    Sensors sensors_;
+    lockfree::SeqLock<ManagerSnapshot> published_;
     
 public:
+    explicit StateMachineManager(Sensors sensors) : sensors_{std::move(sensors)} {}
+
     auto update() -> void {
-        // Process all sensors
-        state_machine_.process_sensors(temp_sensor_, humidity_sensor_, pressure_sensor_);
-        
-        // Get buffer stats using structured binding
-        auto [min_val, max_val] = state_machine_.get_buffer_stats();
+        const alloc::Probe heap;
+
+        // Process all sensors: one registry poll, or the pack expanded in place
+        if constexpr (requires { state_machine_.process_sensors(sensors_); }) {
+            state_machine_.process_sensors(sensors_);
+        } else {
+            std::apply([this](auto&... sensors) { state_machine_.process_sensors(sensors...); }, sensors_);
+        }
+        published_.store({
+            state_machine_.get_current_state_id(),
+            state_machine_.get_samples_ingested(),
+            state_machine_.get_buffer_stats(),
+        });
         
-        // Log state with buffer info
-        ESP_LOGI("StateMachine", 
-            "State: %s | Buffer: %zu samples | Range: [%.1f, %.1f]",
-            state_machine_.get_state_info().c_str(),
-            std::min(state_machine_.get_buffer_index(), 
-                    static_cast<size_t>(10)),
-            min_val, max_val);
+        // Log state with buffer info; described only if the line will print
+        if (logfmt::enabled(TAG, ESP_LOG_INFO)) {
+            const auto& [min_val, max_val, mean_val, count] = state_machine_.get_buffer_stats();
+            std::array<char, STATE_INFO_SIZE> info;
+            ESP_LOGI(TAG, 
+                "State: %s | Buffer: %zu samples | Range: [%.1f, %.1f] | Mean: %.2f",
+                state_machine_.describe_state(info),
+                count,
+                min_val, max_val, mean_val);
+        }
+
+        // Every sensor, not just the buffered one
+        if (logfmt::enabled(TAG, ESP_LOG_DEBUG)) {
+            const auto& history = state_machine_.get_history();
+            for (size_t ch = 0; ch < history.channels(); ++ch) {
+                const auto& [lo, hi, mean, samples] = history.stats(ch);
+                ESP_LOGD(TAG, "  Sensor %d: %zu samples | Range: [%.1f, %.1f] | Mean: %.2f",
+                    history.id(ch), samples, lo, hi, mean);
+            }
+        }
+
+        // Steady state should never touch the heap
+        if (heap.count() != 0) {
+            ESP_LOGW(TAG, "update() made %u heap allocations (%zu bytes)",
+                static_cast<unsigned>(heap.count()), heap.bytes());
+        }
     }
     
+    // Consistent copy as of the last update(); never blocks update()
+    [[nodiscard]] auto snapshot() const -> ManagerSnapshot {
+        return published_.load();
+    }
+
     [[nodiscard]] auto get_state_id() const -> StateId {
-        return state_machine_.get_current_state_id();
+        return snapshot().state;
     }
 };
 
 // --- Thread Functions with C++23 Features ---
 auto state_monitor_thread([[maybe_unused]] int thread_id) -> void {
-    StateMachineManager manager;
+    // ~1.5 KB with its sensor history: on the heap, not the 4 KB task stack
+    const auto manager = std::make_unique<StateMachineManager<FixedSensors>>(
+        make_fixed_sensors(static_cast<uint32_t>(thread_id)));
     const char* task_name = pcTaskGetName(nullptr);
     
     while (true) {
         // if with initializer
-        if (auto state = manager.get_state_id(); state == StateId::ALERT) {
+        if (auto state = manager->get_state_id(); state == StateId::ALERT) {
             ESP_LOGW(task_name, "Thread %d: CRITICAL ALERT STATE", thread_id);
         }
         
-        manager.update();
-        std::this_thread::sleep_for(STATE_UPDATE_INTERVAL);
+        manager->update();
+        sim::sleep_for(STATE_UPDATE_INTERVAL);
     }
 }
 
 auto sensor_processor_thread() -> void {
     const char* task_name = pcTaskGetName(nullptr);
-    std::vector<StateMachineManager> managers(3);
+    std::vector<StateMachineManager<SensorSet>> managers;
+    managers.reserve(PROCESSOR_MANAGERS);
+    for (uint32_t seed = 100; seed < 100 + PROCESSOR_MANAGERS; ++seed) {
+        managers.emplace_back(make_sensor_set(seed, seed % 2 == 0)); // odd seeds run without pressure
+    }
+
+    // Updates spread over pinned workers, idle ones steal from busy ones
+    exec::Executor executor{{
+        .workers = PROCESSOR_WORKERS,
+        .stack_size = 4096,
+        .prio = 6,
+        .name = "SensorWork",
+    }};
     
     // Range-based for with init - using the manager
     for (size_t i = 0; auto& manager : managers) {
@@ -257,12 +420,12 @@ auto sensor_processor_thread() -> void {
     }
     
     while (true) {
-        // Process each manager
-        for (auto& manager : managers) {
-            manager.update();
-        }
+        // Process each manager, on both cores
+        executor.parallel_for(managers.size(), 1, [&managers](size_t i) {
+            managers[i].update();
+        });
         
-        std::this_thread::sleep_for(1s);
+        sim::sleep_for(1s);
     }
 }
 
@@ -291,7 +454,7 @@ extern "C" void app_main(void) {
     []() {
         auto cfg = create_config("StateMon", 0, 4096, 5);
         esp_pthread_set_cfg(&cfg);
-        std::jthread monitor([]() { state_monitor_thread(1); });
+        std::jthread monitor(sim::task([]() { state_monitor_thread(1); }));
         monitor.detach();
     }();
     
@@ -299,15 +462,16 @@ extern "C" void app_main(void) {
     []() {
         auto cfg = create_config("SensorProc", 1, 4096, 6);
         esp_pthread_set_cfg(&cfg);
-        std::jthread processor(sensor_processor_thread);
+        std::jthread processor(sim::task(sensor_processor_thread));
         processor.detach();
     }();
     
-    // Thread 3: Another State Monitor on Any Core
+    // Thread 3: Another State Monitor on Any Core; the default pthread
+    // stack is too small for update()'s formatting and float logging
     []() {
-        auto cfg = esp_pthread_get_default_config();
+        auto cfg = create_config("StateMon2", tskNO_AFFINITY, 4096, 5);
         esp_pthread_set_cfg(&cfg);
-        std::jthread monitor([]() { state_monitor_thread(2); });
+        std::jthread monitor(sim::task([]() { state_monitor_thread(2); }));
         monitor.detach();
     }();
     
@@ -320,7 +484,20 @@ extern "C" void app_main(void) {
             "Main task cycle %d | Min free stack: %d bytes",
             ++cycle,
             uxTaskGetStackHighWaterMark(nullptr));
+
+        // Handler histograms, only with -DFSM_PROFILE=1
+        if (FSM_PROFILE && cycle % PROFILE_DUMP_EVERY == 0) {
+            profile::dump(main_task_name);
+        }
+
+        // Coroutine frame sizes as the compiler laid them out
+        if (cycle % ARENA_REPORT_EVERY == 0) {
+            const auto arena = fsm::frame_arena().stats();
+            ESP_LOGI(main_task_name,
+                "Flow frames: %zu/%zu in use (peak %zu) | largest %zu of %zu bytes | %zu refused",
+                arena.in_use, arena.blocks, arena.peak, arena.largest, arena.block_size, arena.failures);
+        }
         
-        std::this_thread::sleep_for(LOG_INTERVAL);
+        sim::sleep_for(LOG_INTERVAL);
     }
 }
\ No newline at end of file
@@ -6,13 +6,21 @@
 #include <concepts>
 #include <thread>
 #include <chrono>
-#include <format>
+#include <cinttypes>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <esp_log.h>
 #include <esp_pthread.h>
 
+#include "binlog.hpp"
+#include "fsm_event.hpp"
+#include "fsm_table.hpp"
+#include "mpsc_queue.hpp"
+#include "sim_clock.hpp"
+#include "sliding_window.hpp"
+#include "timer_wheel.hpp"
+
 //------------------------------------------------------------
 // Feature test macros / __has_include
 //------------------------------------------------------------
@@ -46,6 +54,14 @@ constexpr T clamp_value(T v, T lo, T hi)
 struct EvInit {};
 struct EvTick {};
 struct EvError { int code; };
+struct EvSample { int value; };
+
+// Any event, so it can be queued and handed across tasks
+using Event = fsm::packed_event<EvInit, EvTick, EvError, EvSample>;
+
+static_assert(sizeof(Event) <= 8, "events are pushed through queues by value");
+static_assert(sizeof(Event::tag_type) == 1);
+static_assert(std::is_trivially_copyable_v<Event>);
 
 //------------------------------------------------------------
 // States
@@ -54,16 +70,31 @@ struct Idle {
     [[maybe_unused]] uint32_t counter = 0;
 };
 
+static constexpr std::size_t WINDOW_SIZE = 8;
+
+// Composite state: data and reactions shared by its substates
 struct Running {
-    std::span<const int> samples;   // span feature
+    MinMaxWindow<int, WINDOW_SIZE> window;   // last WINDOW_SIZE samples
+};
+
+struct Sampling : Running {
+    using parent = Running;
+};
+
+// Samples close to the limit, still running
+struct Degraded : Running {
+    using parent = Running;
 };
 
 struct Error {
     int code;
 };
 
-// Variant-based FSM state
-using State = std::variant<Idle, Running, Error>;
+// Variant-based FSM state: leaves only, Running is reached through them
+using State = std::variant<Idle, Sampling, Degraded, Error>;
+
+static constexpr int OVERLOAD_LIMIT = 90;
+static constexpr int DEGRADED_LIMIT = 80;
 
 //------------------------------------------------------------
 // State Machine
@@ -74,73 +105,161 @@ public:
         : sensor_data_{sensor_data}
     {}
 
-    void dispatch(auto&& event)
+    // One indexed jump through the transition table per event
+    void dispatch(const auto& event)
     {
-        std::visit(
-            [this, &event]<typename S>(S& state) {
-                handle(state, event);
-            },
-            state_
-        );
+        if (!Table::dispatch(*this, state_, event)) {
+            ESP_LOGD(TAG, "Unhandled event in state %zu", state_.index());
+        }
+    }
+
+    void dispatch(const Event& event)
+    {
+        if (!Table::dispatch_event(*this, state_, event)) {
+            ESP_LOGD(TAG, "Unhandled event %zu in state %zu", event.index(), state_.index());
+        }
+    }
+
+    // Backlog replay; runs of identical events share one handler lookup
+    void dispatch_many(std::span<const Event> events)
+    {
+        if (const auto handled = Table::dispatch_many(*this, state_, events); handled != events.size()) {
+            ESP_LOGD(TAG, "%zu of %zu events unhandled", events.size() - handled, events.size());
+        }
     }
 
 private:
     //--------------------------------------------------------
-    // Helpers
+    // Guards
     //--------------------------------------------------------
-    static auto minmax_samples(std::span<const int> s)
+    bool has_samples(const Idle&, const EvInit&) const
     {
-        int min = s.front();
-        int max = s.front();
+        return !sensor_data_.empty();
+    }
 
-        // range-for with init
-        for (bool first = true; const int v : s) {
-            if (first) {
-                first = false;
-                continue;
-            }
-            min = std::min(min, v);
-            max = std::max(max, v);
-        }
-        return std::pair{ min, max }; // structured bindings target
+    bool is_overloaded(const Running& s, const EvTick&) const
+    {
+        return s.window.max() > OVERLOAD_LIMIT;
+    }
+
+    // Overload is left to the Running row
+    bool is_degraded(const Sampling& s, const EvTick&) const
+    {
+        const int max = s.window.max();
+        return max > DEGRADED_LIMIT && max <= OVERLOAD_LIMIT;
+    }
+
+    bool is_recovered(const Degraded& s, const EvTick&) const
+    {
+        return s.window.max() <= DEGRADED_LIMIT;
     }
 
     //--------------------------------------------------------
-    // Handlers (overload set)
+    // Actions
     //--------------------------------------------------------
-    void handle(Idle& s, const EvInit&)
+    // Seeds the window with the initial sensor data
+    Sampling start(Idle&, const EvInit&)
     {
         ESP_LOGI(TAG, "Transition: Idle -> Running");
-        state_ = Running{ sensor_data_ };
+        Sampling next{};
+        for (const int v : sensor_data_) {
+            next.window.push(v);
+        }
+        return next;
     }
 
-    void handle(Running& s, const EvTick&)
+    Error overload(Running& s, const EvTick&)
     {
-        // if with initializer + structured bindings
-        if (const auto [min, max] = minmax_samples(s.samples); max > 90) {
-            ESP_LOGW(TAG, "Sensor overload detected");
-            state_ = Error{ max };
-        } else {
-            ESP_LOGI(TAG, "Running: min=%d max=%d", min, max);
-        }
+        ESP_LOGW(TAG, "Sensor overload detected");
+        return Error{ s.window.max() };
     }
 
-    void handle(Error& e, const EvTick&)
+    // Amortized O(1) per sample, no rescan
+    void ingest(Running& s, const EvSample& e)
     {
-        ESP_LOGE(TAG, "Error state, code=%d", e.code);
+        s.window.push(e.value);
+    }
+
+    Error fail(Running&, const EvError& e)
+    {
+        return Error{ e.code };
     }
 
-    template <typename S, typename E>
-    void handle(S&, const E&)
+    Degraded degrade(Sampling& s, const EvTick&)
     {
-        // default: ignore
+        ESP_LOGW(TAG, "Samples near limit, degraded");
+        return Degraded{ s };
+    }
+
+    Sampling recover(Degraded& s, const EvTick&)
+    {
+        ESP_LOGI(TAG, "Samples back in range");
+        return Sampling{ s };
+    }
+
+    void enter_running(Running& s)
+    {
+        ESP_LOGI(TAG, "Enter Running (%zu samples)", s.window.size());
+    }
+
+    void exit_running(Running&)
+    {
+        ESP_LOGI(TAG, "Exit Running");
+    }
+
+    void sample(Running& s, const EvTick&)
+    {
+        // Every tick: record only, the log drain task formats it
+        BINLOGI(TAG, "Running: min=%d max=%d", s.window.min(), s.window.max());
+    }
+
+    void report(Error& e, const EvTick&)
+    {
+        ESP_LOGE(TAG, "Error state, code=%d", e.code);
     }
 
+    //--------------------------------------------------------
+    // Transition table: pairs without a row are reported, not
+    // silently swallowed by a catch-all overload. Substate rows
+    // are tried first, then the event bubbles up to Running.
+    //--------------------------------------------------------
+    using Table = fsm::table<StateMachine, State,
+        fsm::transition<Idle,     EvInit,  Sampling, &StateMachine::start,    &StateMachine::has_samples>,
+        fsm::transition<Sampling, EvTick,  Degraded, &StateMachine::degrade,  &StateMachine::is_degraded>,
+        fsm::transition<Degraded, EvTick,  Sampling, &StateMachine::recover,  &StateMachine::is_recovered>,
+        fsm::transition<Running,  EvTick,  Error,    &StateMachine::overload, &StateMachine::is_overloaded>,
+        fsm::internal<Running,    EvTick,            &StateMachine::sample>,
+        fsm::internal<Running,    EvSample,          &StateMachine::ingest>,
+        fsm::transition<Running,  EvError, Error,    &StateMachine::fail>,
+        fsm::internal<Error,      EvTick,            &StateMachine::report>,
+        fsm::on_entry<Running, &StateMachine::enter_running>,
+        fsm::on_exit<Running,  &StateMachine::exit_running>
+    >;
+
+public:
+    static constexpr fsm::TableReport table_report = Table::report<Event>;
+
 private:
     State state_{ Idle{} };
     std::span<const int> sensor_data_;
 };
 
+//------------------------------------------------------------
+// Event queue: any task may post, only app_main dispatches
+//------------------------------------------------------------
+using EventQueue = lockfree::MpscQueue<Event, 32>;
+
+static constexpr auto TICK_INTERVAL = 2s;
+static constexpr auto SAMPLE_INTERVAL = 500ms;
+static constexpr auto TIMER_RESOLUTION = 10ms;
+static constexpr std::size_t TIMER_CAPACITY = 4;
+static constexpr std::uint32_t TIMER_TICK = 0;   // wheel user ids
+static constexpr std::uint32_t TIMER_SAMPLE = 1;
+static constexpr auto DRAIN_INTERVAL = 100ms;
+static constexpr std::size_t DRAIN_BATCH = 8;
+static constexpr auto LOG_DRAIN_INTERVAL = 250ms;
+static constexpr std::size_t PROFILE_DUMP_EVERY = 300; // owner loop passes, ~30 s
+
 //------------------------------------------------------------
 // Thread entry
 //------------------------------------------------------------
@@ -150,13 +269,67 @@ extern "C" void app_main()
     static constexpr std::array<int, 8> sensor_samples{
         10, 20, 30, 40, 55, 60, 70, 95
     };
+    static EventQueue events;
 
     StateMachine fsm{ std::span{ sensor_samples } };
 
-    fsm.dispatch(EvInit{});
+    constexpr auto table = StateMachine::table_report;
+    ESP_LOGI(TAG, "Table: %zu/%zu states reachable, %zu of %zu cells handled",
+        table.reachable_states, table.states, table.live_cells, table.cells);
+
+    events.try_push(EvInit{});
+
+    // Tick and sample producers: periodic timers on one wheel task,
+    // which can pace any number of FSMs; other tasks post the same way
+    static timing::TimerWheel<TIMER_CAPACITY> wheel;
+    wheel.schedule(TICK_INTERVAL / TIMER_RESOLUTION, TICK_INTERVAL / TIMER_RESOLUTION, TIMER_TICK);
+    wheel.schedule(SAMPLE_INTERVAL / TIMER_RESOLUTION, SAMPLE_INTERVAL / TIMER_RESOLUTION, TIMER_SAMPLE);
+
+    std::jthread timers(sim::task([] {
+        std::size_t sample = 0;
+        timing::drive(wheel, TIMER_RESOLUTION, [&sample](std::uint32_t timer) {
+            if (timer == TIMER_TICK) {
+                if (!events.try_push(EvTick{})) {
+                    ESP_LOGW(TAG, "Event queue full, tick dropped");
+                }
+                const auto s = wheel.stats();
+                ESP_LOGD(TAG, "Timers: fired=%" PRIu64 " max lateness=%" PRIu64 " ticks, %.0f %s per fire",
+                    s.fired, s.max_lateness, s.mean_cost_per_fire, cycles::unit);
+            } else {
+                // Replays the sensor buffer as a live stream
+                if (!events.try_push(EvSample{ sensor_samples[sample++ % sensor_samples.size()] })) {
+                    ESP_LOGW(TAG, "Event queue full, sample dropped");
+                }
+            }
+        });
+    }));
+    timers.detach();
+
+    // Log drain at the lowest priority; formatting and UART I/O happen here
+    []() {
+        auto cfg = esp_pthread_get_default_config();
+        cfg.thread_name = "binlog";
+        cfg.prio = 1;
+        esp_pthread_set_cfg(&cfg);
+        std::jthread log_drain(sim::task(binlog::drain_task), std::chrono::milliseconds{ LOG_DRAIN_INTERVAL });
+        log_drain.detach();
+    }();
 
-    while (true) {
-        fsm.dispatch(EvTick{});
-        std::this_thread::sleep_for(2s);
+    // FSM owner: drain in batches
+    std::array<Event, DRAIN_BATCH> batch;
+    for (std::size_t pass = 1;; ++pass) {
+        std::size_t n = 0;
+        events.drain([&batch, &n](const Event& e) { batch[n++] = e; }, batch.size());
+        if (n > 0) {
+            fsm.dispatch_many(std::span{ batch }.first(n));
+            const auto [depth, drops, max_latency_us] = events.stats();
+            ESP_LOGD(TAG, "Queue depth=%zu drops=%" PRIu32 " max latency=%" PRIu32 "us",
+                depth, drops, max_latency_us);
+        }
+        // Per-(state, event) handler histograms, only with -DFSM_PROFILE=1
+        if (FSM_PROFILE && pass % PROFILE_DUMP_EVERY == 0) {
+            profile::dump(TAG);
+        }
+        sim::sleep_for(DRAIN_INTERVAL);
     }
 }
@@ -0,0 +1,38 @@
+// cycles.hpp
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if __has_include(<esp_cpu.h>)
+#  include <esp_cpu.h>
+#  define CYCLES_HAS_ESP_CPU 1
+#endif
+
+//------------------------------------------------------------
+// Cheapest timestamp available for short intervals
+//
+// On target this is the CPU cycle counter (one register read).
+// On host it falls back to steady_clock nanoseconds, so numbers
+// from host runs are in ns; cycles::unit says which. 32 bits
+// wide: it wraps, only differences are meaningful.
+//------------------------------------------------------------
+namespace cycles {
+
+#if defined(CYCLES_HAS_ESP_CPU)
+inline constexpr const char* unit = "cycles";
+
+inline std::uint32_t now()
+{
+    return static_cast<std::uint32_t>(esp_cpu_get_cycle_count());
+}
+#else
+inline constexpr const char* unit = "ns";
+
+inline std::uint32_t now()
+{
+    return static_cast<std::uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+#endif
+
+} // namespace cycles
@@ -0,0 +1,102 @@
+// fsm_event.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// Compact runtime event: one-byte tag + union of the payloads
+//
+// Unlike std::variant, the layout is guaranteed: the event is
+// trivially copyable, the tag is a single byte and the size is
+// the largest payload rounded up to its alignment plus the tag.
+// That makes it safe to memcpy through queues and ring buffers.
+//------------------------------------------------------------
+namespace fsm {
+
+namespace detail {
+
+template <typename... Es>
+union event_storage {};
+
+template <typename E, typename... Rest>
+union event_storage<E, Rest...> {
+    constexpr event_storage() : head{} {}
+    constexpr explicit event_storage(const E& e) : head{ e } {}
+    template <typename Other>
+    constexpr explicit event_storage(const Other& e) : tail{ e } {}
+
+    E head;
+    event_storage<Rest...> tail;
+};
+
+template <typename E, typename First, typename... Rest>
+constexpr const E& storage_get(const event_storage<First, Rest...>& s)
+{
+    if constexpr (std::is_same_v<E, First>) {
+        return s.head;
+    } else {
+        return storage_get<E>(s.tail);
+    }
+}
+
+} // namespace detail
+
+template <typename... Es>
+class packed_event {
+    static_assert(sizeof...(Es) > 0 && sizeof...(Es) <= 255, "tag is one byte");
+    static_assert((std::is_trivially_copyable_v<Es> && ...), "payloads must be trivially copyable");
+
+public:
+    using tag_type = std::uint8_t;
+
+    template <typename E>
+    static constexpr bool contains = (std::is_same_v<E, Es> || ...);
+
+    constexpr packed_event() = default;
+
+    template <typename E>
+        requires contains<E>
+    constexpr packed_event(const E& e) // NOLINT: implicit, like std::variant
+        : storage_{ e }
+        , tag_{ static_cast<tag_type>(detail::index_in<E, Es...>) }
+    {}
+
+    [[nodiscard]] constexpr std::size_t index() const { return tag_; }
+
+    template <typename E>
+        requires contains<E>
+    [[nodiscard]] constexpr bool holds() const
+    {
+        return tag_ == detail::index_in<E, Es...>;
+    }
+
+    // Unchecked access, as used by fsm::table once the tag is known
+    template <typename E>
+        requires contains<E>
+    friend constexpr const E& get(const packed_event& ev)
+    {
+        return detail::storage_get<E>(ev.storage_);
+    }
+
+    template <typename E>
+        requires contains<E>
+    [[nodiscard]] constexpr const E* get_if() const
+    {
+        return holds<E>() ? &detail::storage_get<E>(storage_) : nullptr;
+    }
+
+private:
+    detail::event_storage<Es...> storage_{};
+    tag_type tag_ = 0;
+};
+
+template <typename... Es>
+struct alternatives<packed_event<Es...>> {
+    using type = event_list<Es...>;
+};
+
+} // namespace fsm
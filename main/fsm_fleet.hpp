@@ -0,0 +1,132 @@
+// fsm_fleet.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "fsm_table.hpp"
+
+//------------------------------------------------------------
+// Many instances of one FSM in structure-of-arrays layout
+//
+// Instead of N std::variant objects, the fleet keeps one byte
+// of state index per instance plus one contiguous column per
+// state type (so every Idle counter sits next to the others,
+// every Error code next to the others, ...). Stepping the fleet
+// walks the index array once and runs the same fsm::table
+// handlers a single StateMachine would, through a Slot that
+// stands in for the variant. The handlers share one Machine
+// object as context, so per-instance data belongs in the states.
+//
+// Memory is size() * (1 + sum of sizeof(S)), which suits small
+// states; instances never move, so indices are stable handles.
+//------------------------------------------------------------
+namespace fsm {
+
+template <typename Table, typename StateVariant = typename Table::state_type>
+class FsmFleet;
+
+template <typename Table, typename... Ss>
+class FsmFleet<Table, std::variant<Ss...>> {
+    static_assert(sizeof...(Ss) <= 255, "state index is one byte");
+
+public:
+    using machine_type = typename Table::machine_type;
+
+    // Every instance starts in the first state, default-constructed
+    explicit FsmFleet(std::size_t size)
+        : index_(size, 0)
+        , columns_{ std::vector<Ss>(size)... }
+    {}
+
+    // What fsm::table sees for instance i in place of a std::variant.
+    // Holds raw column pointers so a step loop keeps them in registers.
+    class Slot {
+    public:
+        std::size_t index() const { return index_[i_]; }
+
+        template <typename S>
+        S& get() { return std::get<S*>(columns_)[i_]; }
+
+        template <typename T>
+        void set(T&& next)
+        {
+            using S = std::remove_cvref_t<T>;
+            get<S>() = std::forward<T>(next);
+            index_[i_] = static_cast<std::uint8_t>(detail::index_in<S, Ss...>);
+        }
+
+    private:
+        friend class FsmFleet;
+        explicit Slot(FsmFleet& fleet, std::size_t i = 0)
+            : index_{ fleet.index_.data() }
+            , columns_{ fleet.template column<Ss>().data()... }
+            , i_{ i }
+        {}
+
+        std::uint8_t* index_;
+        std::tuple<Ss*...> columns_;
+        std::size_t i_;
+    };
+
+    // Applies a typed event to every instance; returns how many handled it
+    template <typename E>
+    std::size_t step(machine_type& m, const E& e)
+    {
+        if constexpr (!(Table::template live<Ss, E> || ...)) {
+            return 0;
+        } else {
+            std::size_t handled = 0;
+            for (Slot slot{ *this }; slot.i_ < index_.size(); ++slot.i_) {
+                handled += Table::dispatch(m, slot, e);
+            }
+            return handled;
+        }
+    }
+
+    // Same for a runtime event (std::variant or packed_event)
+    template <typename EventVariant>
+    std::size_t step_event(machine_type& m, const EventVariant& ev)
+    {
+        std::size_t handled = 0;
+        for (Slot slot{ *this }; slot.i_ < index_.size(); ++slot.i_) {
+            handled += Table::dispatch_event(m, slot, ev);
+        }
+        return handled;
+    }
+
+    // Single-instance access, e.g. to feed one channel its own event
+    Slot operator[](std::size_t i) { return Slot{ *this, i }; }
+
+    template <typename S>
+    [[nodiscard]] bool holds(std::size_t i) const { return index_[i] == detail::index_in<S, Ss...>; }
+
+    template <typename S>
+    [[nodiscard]] S& get(std::size_t i) { return column<S>()[i]; }
+
+    template <typename S>
+    [[nodiscard]] std::size_t count() const
+    {
+        std::size_t n = 0;
+        for (const std::uint8_t idx : index_) {
+            n += idx == detail::index_in<S, Ss...>;
+        }
+        return n;
+    }
+
+    [[nodiscard]] std::size_t size() const { return index_.size(); }
+
+private:
+    template <typename S>
+    std::vector<S>& column() { return std::get<std::vector<S>>(columns_); }
+
+    std::vector<std::uint8_t> index_;
+    std::tuple<std::vector<Ss>...> columns_;
+};
+
+} // namespace fsm
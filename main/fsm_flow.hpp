@@ -0,0 +1,264 @@
+// fsm_flow.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+//------------------------------------------------------------
+// Coroutine flows: linear multi-tick procedures inside a state
+//
+//   fsm::Flow<float> calibrate()
+//   {
+//       for (int step = 0; step < 5; ++step) {
+//           const float reading = co_await fsm::next_tick();
+//           ...
+//       }
+//   }
+//
+// A flow starts suspended. Each resume(tick) hands it one tick;
+// co_await next_tick() takes the pending tick, or suspends until
+// the next resume delivers one. resume() returns false once the
+// body has returned, which is the owner's cue to transition.
+//
+// Frames come from a fixed arena (FSM_FLOW_FRAMES blocks of
+// FSM_FLOW_FRAME_SIZE bytes), never the heap. When the arena is
+// full or a frame does not fit, the flow is empty (false) and
+// resume() returns false at once. frame_size() and
+// frame_arena().stats() report the actual frame sizes at run time.
+//------------------------------------------------------------
+#ifndef FSM_FLOW_FRAME_SIZE
+#  define FSM_FLOW_FRAME_SIZE 256
+#endif
+#ifndef FSM_FLOW_FRAMES
+#  define FSM_FLOW_FRAMES 16
+#endif
+
+namespace fsm {
+
+struct ArenaStats {
+    std::size_t block_size;  // usable bytes per frame
+    std::size_t blocks;
+    std::size_t in_use;
+    std::size_t peak;
+    std::size_t largest;     // biggest frame requested, fitted or not
+    std::size_t failures;    // requests refused: arena full or frame too big
+};
+
+//------------------------------------------------------------
+// Fixed-size blocks on a lock-free free list (Treiber stack,
+// 16-bit index + 16-bit ABA tag in one 32-bit word, so it stays
+// lock-free on 32-bit cores).
+//------------------------------------------------------------
+template <std::size_t BlockSize, std::size_t Blocks>
+class FrameArena {
+    static_assert(BlockSize > 0 && BlockSize % alignof(std::max_align_t) == 0);
+    static_assert(Blocks > 0 && Blocks < 0xFFFF);
+
+public:
+    FrameArena()
+    {
+        for (std::size_t i = 0; i < Blocks; ++i) {
+            next_[i].store(static_cast<std::uint16_t>(i + 1 < Blocks ? i + 1 : NIL), std::memory_order_relaxed);
+        }
+        head_.store(pack(0, 0), std::memory_order_relaxed);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t n) noexcept
+    {
+        update_max(largest_, n);
+        const std::uint16_t i = n <= BlockSize ? pop() : NIL;
+        if (i == NIL) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        update_max(peak_, in_use_.fetch_add(1, std::memory_order_relaxed) + 1);
+        return &storage_[i * BlockSize];
+    }
+
+    // frame: a pointer allocate() returned
+    void deallocate(void* frame) noexcept
+    {
+        const auto offset = static_cast<std::size_t>(static_cast<std::byte*>(frame) - storage_.data());
+        push(static_cast<std::uint16_t>(offset / BlockSize));
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] ArenaStats stats() const
+    {
+        return {
+            .block_size = BlockSize,
+            .blocks = Blocks,
+            .in_use = in_use_.load(std::memory_order_relaxed),
+            .peak = peak_.load(std::memory_order_relaxed),
+            .largest = largest_.load(std::memory_order_relaxed),
+            .failures = failures_.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    static constexpr std::uint16_t NIL = 0xFFFF;
+
+    static constexpr std::uint32_t pack(std::uint16_t index, std::uint16_t tag)
+    {
+        return static_cast<std::uint32_t>(tag) << 16 | index;
+    }
+    static constexpr std::uint16_t index_of(std::uint32_t head) { return static_cast<std::uint16_t>(head); }
+    static constexpr std::uint16_t tag_of(std::uint32_t head) { return static_cast<std::uint16_t>(head >> 16); }
+
+    std::uint16_t pop()
+    {
+        std::uint32_t head = head_.load(std::memory_order_acquire);
+        while (index_of(head) != NIL) {
+            const std::uint16_t next = next_[index_of(head)].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(next, tag_of(head) + 1),
+                    std::memory_order_acquire, std::memory_order_acquire)) {
+                return index_of(head);
+            }
+        }
+        return NIL;
+    }
+
+    void push(std::uint16_t i)
+    {
+        std::uint32_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[i].store(index_of(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack(i, tag_of(head) + 1),
+            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static void update_max(std::atomic<std::size_t>& m, std::size_t v)
+    {
+        std::size_t cur = m.load(std::memory_order_relaxed);
+        while (cur < v && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    alignas(std::max_align_t) std::array<std::byte, BlockSize * Blocks> storage_;
+    std::array<std::atomic<std::uint16_t>, Blocks> next_;
+    std::atomic<std::uint32_t> head_;
+    std::atomic<std::size_t> in_use_{ 0 };
+    std::atomic<std::size_t> peak_{ 0 };
+    std::atomic<std::size_t> largest_{ 0 };
+    std::atomic<std::size_t> failures_{ 0 };
+};
+
+using FlowArena = FrameArena<FSM_FLOW_FRAME_SIZE, FSM_FLOW_FRAMES>;
+
+namespace detail {
+
+// Size passed to the last promise_type::operator new on this task. The
+// promise is constructed right after its frame is allocated, on the same
+// task, and copies it from here: where the frame sits inside the
+// allocation is up to the compiler.
+inline thread_local std::size_t requested_frame_size = 0;
+
+} // namespace detail
+
+inline FlowArena& frame_arena()
+{
+    static FlowArena arena;
+    return arena;
+}
+
+//------------------------------------------------------------
+// co_await fsm::next_tick()
+//------------------------------------------------------------
+struct next_tick_t {};
+
+inline constexpr next_tick_t next_tick() { return {}; }
+
+template <typename Tick>
+class [[nodiscard]] Flow {
+public:
+    struct promise_type {
+        std::optional<Tick> pending;
+        std::size_t frame_size = detail::requested_frame_size;
+
+        static void* operator new(std::size_t n) noexcept
+        {
+            detail::requested_frame_size = n;
+            return frame_arena().allocate(n);
+        }
+        static void operator delete(void* frame) noexcept { frame_arena().deallocate(frame); }
+        static Flow get_return_object_on_allocation_failure() noexcept { return {}; }
+
+        Flow get_return_object() noexcept
+        {
+            return Flow{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        auto await_transform(next_tick_t) noexcept
+        {
+            struct Awaiter {
+                promise_type& p;
+                bool await_ready() const noexcept { return p.pending.has_value(); }
+                void await_suspend(std::coroutine_handle<>) const noexcept {}
+                Tick await_resume() const { return *std::exchange(p.pending, std::nullopt); }
+            };
+            return Awaiter{ *this };
+        }
+    };
+
+    Flow() = default;
+    Flow(Flow&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Flow& operator=(Flow&& other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~Flow() { destroy(); }
+
+    // False when the frame could not be allocated
+    explicit operator bool() const noexcept { return static_cast<bool>(handle_); }
+
+    [[nodiscard]] bool done() const noexcept { return !handle_ || handle_.done(); }
+
+    // Delivers one tick; false once the flow has finished
+    bool resume(Tick tick)
+    {
+        if (done()) {
+            return false;
+        }
+        handle_.promise().pending = std::move(tick);
+        handle_.resume();
+        return !handle_.done();
+    }
+
+    // Bytes the compiler asked operator new for
+    [[nodiscard]] std::size_t frame_size() const noexcept
+    {
+        return handle_ ? handle_.promise().frame_size : 0;
+    }
+
+private:
+    explicit Flow(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+    void destroy() noexcept
+    {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+} // namespace fsm
@@ -0,0 +1,188 @@
+// fsm_profile.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <esp_log.h>
+
+#include "cycles.hpp"
+
+//------------------------------------------------------------
+// Opt-in per-(state, event) handler timing
+//
+// Build with -DFSM_PROFILE=1 and every fsm::table handler call
+// (each dispatch_many run counts as one call, and any
+// FSM_PROFILE_SCOPE you add) is timed with cycles::now()
+// into a log2 histogram owned by that call site. profile::dump()
+// logs every histogram that has samples, profile::reset() clears
+// them. With FSM_PROFILE=0 (the default) the macro expands to
+// nothing: no counter reads, no statics, no code.
+//------------------------------------------------------------
+#ifndef FSM_PROFILE
+#  define FSM_PROFILE 0
+#endif
+
+namespace profile {
+
+// Short type name for reports: "Idle", not "{anonymous}::Idle"
+template <typename T>
+constexpr std::string_view type_name()
+{
+    constexpr std::string_view pretty = __PRETTY_FUNCTION__;
+    constexpr std::size_t begin = pretty.find("T = ") + 4;
+    constexpr std::string_view full = pretty.substr(begin, pretty.find_first_of(";]", begin) - begin);
+    constexpr std::size_t scope = full.substr(0, full.find('<')).rfind("::");
+    return scope == std::string_view::npos ? full : full.substr(scope + 2);
+}
+
+class Histogram {
+public:
+    // Bucket b counts samples in [2^(b-1), 2^b)
+    static constexpr std::size_t BUCKETS = 33;
+
+    // Only for objects with static storage: registers itself for dump()
+    Histogram(std::string_view state, std::string_view event)
+        : state_{ state }
+        , event_{ event }
+        , next_{ head().load(std::memory_order_relaxed) }
+    {
+        while (!head().compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    void record(std::uint32_t elapsed)
+    {
+        buckets_[std::bit_width(elapsed)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        const std::uint32_t low = total_low_.fetch_add(elapsed, std::memory_order_relaxed);
+        if (low + elapsed < low) {
+            total_high_.fetch_add(1, std::memory_order_relaxed); // carry
+        }
+        std::uint32_t seen = max_.load(std::memory_order_relaxed);
+        while (elapsed > seen && !max_.compare_exchange_weak(seen, elapsed, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Upper bound of the bucket holding the q-quantile, q in [0, 1]
+    [[nodiscard]] std::uint64_t quantile_bound(double q) const
+    {
+        const auto n = count_.load(std::memory_order_relaxed);
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(n));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < BUCKETS; ++b) {
+            seen += buckets_[b].load(std::memory_order_relaxed);
+            if (seen > rank) {
+                return std::uint64_t{ 1 } << b;
+            }
+        }
+        return std::uint64_t{ 1 } << (BUCKETS - 1);
+    }
+
+    void dump(const char* tag) const
+    {
+        const auto n = count_.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return;
+        }
+        const auto mean = total() / n;
+        ESP_LOGI(tag, "%.*s/%.*s: n=%u mean=%u p50<%u p99<%u max=%u %s",
+            static_cast<int>(state_.size()), state_.data(),
+            static_cast<int>(event_.size()), event_.data(),
+            static_cast<unsigned>(n), static_cast<unsigned>(mean),
+            static_cast<unsigned>(quantile_bound(0.5)), static_cast<unsigned>(quantile_bound(0.99)),
+            static_cast<unsigned>(max_.load(std::memory_order_relaxed)), cycles::unit);
+    }
+
+    void reset()
+    {
+        for (auto& b : buckets_) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        total_low_.store(0, std::memory_order_relaxed);
+        total_high_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Histogram* next() const { return next_; }
+
+    static std::atomic<Histogram*>& head()
+    {
+        static std::atomic<Histogram*> list{ nullptr };
+        return list;
+    }
+
+private:
+    // Off by one carry only while a record() is between its two adds
+    [[nodiscard]] std::uint64_t total() const
+    {
+        std::uint32_t high = total_high_.load(std::memory_order_relaxed);
+        while (true) {
+            const std::uint32_t low = total_low_.load(std::memory_order_relaxed);
+            const std::uint32_t again = total_high_.load(std::memory_order_relaxed);
+            if (again == high) {
+                return (std::uint64_t{ high } << 32) | low;
+            }
+            high = again;
+        }
+    }
+
+    std::string_view state_;
+    std::string_view event_;
+    std::array<std::atomic<std::uint32_t>, BUCKETS> buckets_{};
+    std::atomic<std::uint32_t> count_{ 0 };
+    // Sum of samples as two 32-bit words: 64-bit atomics are not
+    // lock-free on Xtensa, and a 32-bit sum wraps after ~18 s at 240 MHz
+    std::atomic<std::uint32_t> total_low_{ 0 };
+    std::atomic<std::uint32_t> total_high_{ 0 };
+    std::atomic<std::uint32_t> max_{ 0 };
+    Histogram* next_;
+};
+
+// Times the enclosing scope
+class Scope {
+public:
+    explicit Scope(Histogram& h) : hist_{ h }, start_{ cycles::now() } {}
+    ~Scope() { hist_.record(cycles::now() - start_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Histogram& hist_;
+    std::uint32_t start_;
+};
+
+// Every histogram seen so far; empty when FSM_PROFILE is 0
+inline void dump(const char* tag = "Profile")
+{
+    for (const Histogram* h = Histogram::head().load(std::memory_order_acquire); h; h = h->next()) {
+        h->dump(tag);
+    }
+}
+
+inline void reset()
+{
+    for (Histogram* h = Histogram::head().load(std::memory_order_acquire); h; h = h->next()) {
+        h->reset();
+    }
+}
+
+} // namespace profile
+
+#define FSM_PROFILE_CAT_(a, b) a##b
+#define FSM_PROFILE_CAT(a, b) FSM_PROFILE_CAT_(a, b)
+
+#if FSM_PROFILE
+// One histogram per expansion (and per template instantiation)
+#  define FSM_PROFILE_SCOPE(state_name, event_name)                                          \
+        static ::profile::Histogram FSM_PROFILE_CAT(fsm_profile_hist_, __LINE__){ state_name, event_name }; \
+        const ::profile::Scope FSM_PROFILE_CAT(fsm_profile_scope_, __LINE__){ FSM_PROFILE_CAT(fsm_profile_hist_, __LINE__) }
+#else
+#  define FSM_PROFILE_SCOPE(state_name, event_name) static_cast<void>(0)
+#endif
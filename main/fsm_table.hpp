@@ -0,0 +1,547 @@
+// fsm_table.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "fsm_profile.hpp"
+
+//------------------------------------------------------------
+// Compile-time transition table for std::variant based FSMs
+//
+// Every (State, Event) pair is resolved to a single handler
+// function when the table is instantiated, so dispatching a
+// typed event is one indexed jump through a constexpr array of
+// handlers, one per state; states without a row for the event
+// share a stub that returns false.
+// Rows are tried in declaration order; the first row whose
+// guard passes wins.
+//
+// Hierarchy: a state declares `using parent = P;` and derives
+// from P, which holds the data shared by its children. Only
+// leaves live in the variant. Rows written for P apply to every
+// descendant after the leaf's own rows (event bubbling), and
+// the exit/entry hooks a transition runs are fixed per (leaf,
+// target) pair at compile time, so deep nesting adds no
+// runtime tree walk.
+//
+// The state argument is normally the StateVariant itself; any
+// store with index(), get<S>() and set(T) works too, which is
+// how FsmFleet keeps its states in columns.
+//
+// Reachability: the initial state is the first alternative (what
+// a default-constructed variant holds). States no chain of
+// transition rows leads to from it are found at compile time and
+// fail the build. A table that means it lists one option among
+// its rows: fsm::strip_unreachable gives their cells the
+// "unhandled" stub, so their handlers are never instantiated;
+// fsm::keep_unreachable builds them anyway (states set from
+// outside the table). Table::report<EventVariant> counts live
+// cells.
+//------------------------------------------------------------
+
+namespace fsm {
+
+// Placeholder for an absent action or guard
+inline constexpr std::nullptr_t none = nullptr;
+
+// From --Event[Guard]/Action--> To
+// Action: To (Machine::*)(From&, const Event&), or none to default-construct To
+// Guard:  bool (Machine::*)(const From&, const Event&) const, or none
+template <typename From, typename Event, typename To, auto Action = none, auto Guard = none>
+struct transition {
+    using state = From;
+    using event = Event;
+    using target = To;
+    static constexpr auto action = Action;
+    static constexpr auto guard = Guard;
+};
+
+// Reaction that stays in State
+// Action: void (Machine::*)(State&, const Event&)
+template <typename State, typename Event, auto Action, auto Guard = none>
+struct internal {
+    using state = State;
+    using event = Event;
+    static constexpr auto action = Action;
+    static constexpr auto guard = Guard;
+};
+
+namespace detail {
+
+struct entry_tag {};
+struct exit_tag {};
+
+} // namespace detail
+
+// Hooks run when State (leaf or parent) is entered or left
+// Action: void (Machine::*)(State&)
+template <typename State, auto Action>
+struct on_entry {
+    using state = State;
+    using event = detail::entry_tag;
+    static constexpr auto action = Action;
+};
+
+template <typename State, auto Action>
+struct on_exit {
+    using state = State;
+    using event = detail::exit_tag;
+    static constexpr auto action = Action;
+};
+
+namespace detail {
+
+// Table options sit in the row list; they match no state or event
+struct option_row {
+    using state = void;
+    using event = void;
+};
+
+} // namespace detail
+
+// Cells of states unreachable from the initial state share the
+// "unhandled" stub: their rows are dropped, dispatch returns false
+struct strip_unreachable : detail::option_row {};
+
+// Unreachable states keep their handlers, e.g. states the machine
+// assigns directly rather than through a transition row
+struct keep_unreachable : detail::option_row {};
+
+// Cell counts for one event type, see table::report
+struct TableReport {
+    std::size_t states;            // leaves in the variant
+    std::size_t reachable_states;  // from the initial state
+    std::size_t cells;             // states x events
+    std::size_t handled_cells;     // some row covers (state, event)
+    std::size_t live_cells;        // handled and reachable: the handlers built
+};
+
+// Alternatives of a runtime event sum type, in index order
+template <typename... Es>
+struct event_list {};
+
+template <typename EventVariant>
+struct alternatives;
+
+template <typename... Es>
+struct alternatives<std::variant<Es...>> {
+    using type = event_list<Es...>;
+};
+
+namespace detail {
+
+template <auto F>
+inline constexpr bool is_none = std::is_null_pointer_v<decltype(F)>;
+
+template <typename Row>
+concept transition_row = requires { typename Row::target; };
+
+template <typename... Ts>
+struct type_list {};
+
+template <typename S>
+struct parent_of {
+    using type = void;
+};
+
+template <typename S>
+    requires requires { typename S::parent; }
+struct parent_of<S> {
+    using type = typename S::parent;
+    static_assert(std::is_base_of_v<type, S>, "a state must derive from its parent");
+};
+
+// S followed by its ancestors, innermost first
+template <typename S, typename... Acc>
+struct lineage {
+    using type = typename lineage<typename parent_of<S>::type, Acc..., S>::type;
+};
+
+template <typename... Acc>
+struct lineage<void, Acc...> {
+    using type = type_list<Acc...>;
+};
+
+template <typename S>
+using lineage_t = typename lineage<S>::type;
+
+template <typename T, typename List>
+inline constexpr bool contains = false;
+
+template <typename T, typename... Ts>
+inline constexpr bool contains<T, type_list<Ts...>> = (std::is_same_v<T, Ts> || ...);
+
+// A transition leaves every state of the source lineage that is
+// not shared with the target (just the leaf for a self transition)
+template <typename X, typename S, typename T>
+inline constexpr bool exits =
+    std::is_same_v<S, T> ? std::is_same_v<X, S> : !contains<X, lineage_t<T>>;
+
+template <typename X, typename S, typename T>
+inline constexpr bool enters =
+    std::is_same_v<S, T> ? std::is_same_v<X, T> : !contains<X, lineage_t<S>>;
+
+// Position of E in Es...
+template <typename E, typename... Es>
+inline constexpr std::size_t index_in = 0;
+
+template <typename E, typename First, typename... Rest>
+inline constexpr std::size_t index_in<E, First, Rest...> =
+    std::is_same_v<E, First> ? 0 : 1 + index_in<E, Rest...>;
+
+// State storage: a std::variant, or any store exposing index(),
+// get<S>() and set(T) (fleet slots, see fsm_fleet.hpp)
+template <typename S, typename... Ts>
+S& state_get(std::variant<Ts...>& v)
+{
+    return *std::get_if<S>(&v);
+}
+
+template <typename S, typename Store>
+S& state_get(Store& store)
+{
+    return store.template get<S>();
+}
+
+template <typename T, typename... Ts>
+void state_set(std::variant<Ts...>& v, T&& next)
+{
+    v = std::forward<T>(next);
+}
+
+template <typename T, typename Store>
+void state_set(Store& store, T&& next)
+{
+    store.set(std::forward<T>(next));
+}
+
+template <typename T, typename Variant>
+inline constexpr std::size_t variant_index = 0;
+
+template <typename T, typename... Ts>
+inline constexpr std::size_t variant_index<T, std::variant<Ts...>> = index_in<T, Ts...>;
+
+template <typename EventVariant, typename E>
+const E& event_as(const EventVariant& ev)
+{
+    using std::get;
+    return get<E>(ev);
+}
+
+} // namespace detail
+
+template <typename Machine, typename StateVariant, typename... Rows>
+class table {
+public:
+    using machine_type = Machine;
+    using state_type = StateVariant;
+
+    template <typename E, typename Store = StateVariant>
+    using cell_fn = bool (*)(Machine&, Store&, const E&);
+
+    // True when at least one row covers (S, E), directly or through a parent
+    template <typename S, typename E>
+    static constexpr bool handles =
+        (... || (detail::contains<typename Rows::state, detail::lineage_t<S>>
+                 && std::is_same_v<typename Rows::event, E>));
+
+    static constexpr std::size_t state_count = std::variant_size_v<StateVariant>;
+
+private:
+    template <typename S>
+    static constexpr void add_edges(std::array<bool, state_count>& targets)
+    {
+        ([&] {
+            if constexpr (detail::transition_row<Rows>) {
+                if constexpr (detail::contains<typename Rows::state, detail::lineage_t<S>>) {
+                    targets[detail::variant_index<typename Rows::target, StateVariant>] = true;
+                }
+            }
+        }(), ...);
+    }
+
+    // Fixed point over the transition rows, starting at alternative 0
+    static constexpr auto compute_reachable()
+    {
+        std::array<std::array<bool, state_count>, state_count> edges{};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (add_edges<std::variant_alternative_t<I, StateVariant>>(edges[I]), ...);
+        }(std::make_index_sequence<state_count>{});
+
+        std::array<bool, state_count> seen{};
+        seen[0] = true;
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (std::size_t from = 0; from < state_count; ++from) {
+                for (std::size_t to = 0; to < state_count && seen[from]; ++to) {
+                    if (edges[from][to] && !seen[to]) {
+                        seen[to] = grew = true;
+                    }
+                }
+            }
+        }
+        return seen;
+    }
+
+    static constexpr std::array<bool, state_count> reachable_ = compute_reachable();
+
+    template <typename S, typename... Es>
+    static constexpr std::size_t count_cells(bool live_only)
+    {
+        return (0 + ... + static_cast<std::size_t>(live_only ? live<S, Es> : handles<S, Es>));
+    }
+
+    template <typename... Es, std::size_t... I>
+    static constexpr TableReport make_report(event_list<Es...>, std::index_sequence<I...>)
+    {
+        return {
+            .states = state_count,
+            .reachable_states = state_count - unreachable_states,
+            .cells = state_count * sizeof...(Es),
+            .handled_cells = (0 + ... + count_cells<std::variant_alternative_t<I, StateVariant>, Es...>(false)),
+            .live_cells = (0 + ... + count_cells<std::variant_alternative_t<I, StateVariant>, Es...>(true)),
+        };
+    }
+
+public:
+    template <typename S>
+    static constexpr bool reachable = reachable_[detail::variant_index<S, StateVariant>];
+
+    static constexpr std::size_t unreachable_states =
+        static_cast<std::size_t>(std::count(reachable_.begin(), reachable_.end(), false));
+
+    static constexpr bool strips = (std::is_same_v<Rows, strip_unreachable> || ...);
+    static constexpr bool keeps = (std::is_same_v<Rows, keep_unreachable> || ...);
+    static_assert(!(strips && keeps), "strip_unreachable and keep_unreachable exclude each other");
+    static_assert(unreachable_states == 0 || strips || keeps,
+                  "a state is unreachable from the first alternative: fix the rows, "
+                  "or list fsm::strip_unreachable / fsm::keep_unreachable");
+
+    // The cells that get a handler: covered by a row, and not stripped
+    template <typename S, typename E>
+    static constexpr bool live = handles<S, E> && (reachable<S> || !strips);
+
+    template <typename EventVariant>
+    static constexpr TableReport report = make_report(typename alternatives<EventVariant>::type{},
+                                                      std::make_index_sequence<state_count>{});
+
+    // Returns false when no row accepted the event
+    template <typename E, typename Store>
+    static bool dispatch(Machine& m, Store& sv, const E& e)
+    {
+        return column<E, Store>[sv.index()](m, sv, e);
+    }
+
+    // Runtime event: one jump through a [state][event] table
+    template <typename EventVariant, typename Store>
+    static bool dispatch_event(Machine& m, Store& sv, const EventVariant& ev)
+    {
+        return grid<EventVariant, Store, cell_fn<EventVariant, Store>, false>[sv.index()][ev.index()](m, sv, ev);
+    }
+
+    // Backlog replay: the handler and the leaf state are looked up
+    // once per run of same-type events, then the rows loop on them
+    // while the state stays the same (one profile sample per run).
+    // Returns the number of events some row accepted.
+    template <typename EventVariant, typename Store>
+    static std::size_t dispatch_many(Machine& m, Store& sv, std::span<const EventVariant> events)
+    {
+        std::size_t handled = 0;
+        const EventVariant* it = events.data();
+        const EventVariant* const last = it + events.size();
+        while (it != last) {
+            it = grid<EventVariant, Store, run_fn<EventVariant, Store>, true>[sv.index()][it->index()](
+                m, sv, it, last, handled);
+        }
+        return handled;
+    }
+
+private:
+    // Row written for level A (S itself or an ancestor) seen from leaf S
+    template <typename Row, typename A, typename S, typename E, typename Store>
+    static bool try_row(Machine& m, Store& sv, S& leaf, const E& e)
+    {
+        if constexpr (!std::is_same_v<typename Row::state, A> || !std::is_same_v<typename Row::event, E>) {
+            return false;
+        } else {
+            A& s = leaf;
+            if constexpr (!detail::is_none<Row::guard>) {
+                if (!(m.*Row::guard)(std::as_const(s), e)) {
+                    return false;
+                }
+            }
+            if constexpr (!detail::transition_row<Row>) {
+                (m.*Row::action)(s, e);
+            } else {
+                using T = typename Row::target;
+                run_exits<S, T>(m, leaf, detail::lineage_t<S>{});
+                if constexpr (detail::is_none<Row::action>) {
+                    detail::state_set(sv, T{});
+                } else {
+                    detail::state_set(sv, (m.*Row::action)(s, e));
+                }
+                run_entries<S, T>(m, detail::state_get<T>(sv), detail::lineage_t<T>{});
+            }
+            return true;
+        }
+    }
+
+    template <typename A, typename S, typename E, typename Store>
+    static bool try_level(Machine& m, Store& sv, S& leaf, const E& e)
+    {
+        return (... || try_row<Rows, A, S, E>(m, sv, leaf, e));
+    }
+
+    // Every row for (S, E), leaf first, then its ancestors
+    template <typename S, typename E, typename Store>
+    static bool try_lineage(Machine& m, Store& sv, S& leaf, const E& e)
+    {
+        return [&]<typename... Levels>(detail::type_list<Levels...>) {
+            return (... || try_level<Levels, S, E>(m, sv, leaf, e));
+        }(detail::lineage_t<S>{});
+    }
+
+    template <typename S, typename E, typename Store>
+    static bool cell(Machine& m, Store& sv, const E& e)
+    {
+        FSM_PROFILE_SCOPE(profile::type_name<S>(), profile::type_name<E>());
+        return try_lineage<S, E>(m, sv, detail::state_get<S>(sv), e);
+    }
+
+    //--------------------------------------------------------
+    // Entry/exit hooks
+    //--------------------------------------------------------
+    template <typename Row, typename Tag, typename X, typename Leaf>
+    static void hook(Machine& m, Leaf& leaf)
+    {
+        if constexpr (std::is_same_v<typename Row::event, Tag> && std::is_same_v<typename Row::state, X>) {
+            (m.*Row::action)(static_cast<X&>(leaf));
+        }
+    }
+
+    template <typename Tag, typename X, typename Leaf>
+    static void run_hooks(Machine& m, Leaf& leaf)
+    {
+        (hook<Rows, Tag, X>(m, leaf), ...);
+    }
+
+    // Innermost first
+    template <typename S, typename T, typename... Levels>
+    static void run_exits(Machine& m, S& leaf, detail::type_list<Levels...>)
+    {
+        ([&] {
+            if constexpr (detail::exits<Levels, S, T>) {
+                run_hooks<detail::exit_tag, Levels>(m, leaf);
+            }
+        }(), ...);
+    }
+
+    // Outermost first
+    template <typename S, typename T, typename... Levels>
+    static void run_entries(Machine& m, T& leaf, detail::type_list<Levels...>)
+    {
+        using levels = std::tuple<Levels...>;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using X = std::tuple_element_t<sizeof...(Levels) - 1 - I, levels>;
+                if constexpr (detail::enters<X, S, T>) {
+                    run_hooks<detail::entry_tag, X>(m, leaf);
+                }
+            }(), ...);
+        }(std::index_sequence_for<Levels...>{});
+    }
+
+    // Typed event: one handler per state, indexed by the variant index
+    template <typename E, typename Store, std::size_t... I>
+    static constexpr auto make_column(std::index_sequence<I...>)
+    {
+        return std::array<cell_fn<E, Store>, sizeof...(I)>{ pick<std::variant_alternative_t<I, StateVariant>, E, Store>()... };
+    }
+
+    template <typename E, typename Store>
+    static constexpr auto column = make_column<E, Store>(std::make_index_sequence<std::variant_size_v<StateVariant>>{});
+
+    template <typename EventVariant, typename Store>
+    using run_fn = const EventVariant* (*)(Machine&, Store&, const EventVariant*,
+                                           const EventVariant*, std::size_t&);
+
+    template <typename S, typename E, typename EventVariant, typename Store>
+    static bool event_cell(Machine& m, Store& sv, const EventVariant& ev)
+    {
+        return pick<S, E, Store>()(m, sv, detail::event_as<EventVariant, E>(ev));
+    }
+
+    template <typename S, typename E, typename EventVariant, typename Store>
+    static const EventVariant* run(Machine& m, Store& sv, const EventVariant* it,
+                                   const EventVariant* last, std::size_t& handled)
+    {
+        const std::size_t event_index = it->index();
+        if constexpr (live<S, E>) {
+            // One profile sample and one state lookup per run. A transition
+            // replaces the leaf, so the run ends when the index moves; a
+            // self-transition reassigns it in place, which keeps `leaf` valid.
+            FSM_PROFILE_SCOPE(profile::type_name<S>(), profile::type_name<E>());
+            S& leaf = detail::state_get<S>(sv);
+            const std::size_t state_index = sv.index();
+            std::size_t accepted = 0;
+            do {
+                accepted += try_lineage<S, E>(m, sv, leaf, detail::event_as<EventVariant, E>(*it));
+                ++it;
+            } while (it != last && it->index() == event_index && sv.index() == state_index);
+            handled += accepted;
+        } else {
+            do {
+                ++it;
+            } while (it != last && it->index() == event_index);
+        }
+        return it;
+    }
+
+    template <typename EventVariant, typename Store, typename Fn, bool Run, typename S, typename... Es>
+    static constexpr auto make_grid_row(event_list<Es...>)
+    {
+        if constexpr (Run) {
+            return std::array<Fn, sizeof...(Es)>{ &run<S, Es, EventVariant, Store>... };
+        } else {
+            return std::array<Fn, sizeof...(Es)>{ &event_cell<S, Es, EventVariant, Store>... };
+        }
+    }
+
+    template <typename EventVariant, typename Store, typename Fn, bool Run, std::size_t... I>
+    static constexpr auto make_grid(std::index_sequence<I...>)
+    {
+        using list = typename alternatives<EventVariant>::type;
+        return std::array{
+            make_grid_row<EventVariant, Store, Fn, Run, std::variant_alternative_t<I, StateVariant>>(list{})...
+        };
+    }
+
+    template <typename EventVariant, typename Store, typename Fn, bool Run>
+    static constexpr auto grid =
+        make_grid<EventVariant, Store, Fn, Run>(std::make_index_sequence<std::variant_size_v<StateVariant>>{});
+
+    template <typename E, typename Store>
+    static bool unhandled(Machine&, Store&, const E&)
+    {
+        return false;
+    }
+
+    template <typename S, typename E, typename Store>
+    static constexpr cell_fn<E, Store> pick()
+    {
+        if constexpr (live<S, E>) {
+            return &cell<S, E, Store>;
+        } else {
+            return &unhandled<E, Store>;
+        }
+    }
+};
+
+} // namespace fsm
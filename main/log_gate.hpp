@@ -0,0 +1,23 @@
+// log_gate.hpp
+#pragma once
+
+#include <esp_log.h>
+
+//------------------------------------------------------------
+// Would ESP_LOGx print for this tag and level?
+//
+// ESP_LOGx evaluates its arguments before the runtime level
+// check, so a std::string built for the message is paid for even
+// when the line is filtered out. Wrap expensive arguments:
+//   if (logfmt::enabled(TAG, ESP_LOG_INFO)) { ... ESP_LOGI ... }
+// The compile-time ceiling (LOG_LOCAL_LEVEL) folds the branch
+// away entirely; the runtime part is esp_log_level_get(tag).
+//------------------------------------------------------------
+namespace logfmt {
+
+[[nodiscard]] inline bool enabled(const char* tag, esp_log_level_t level)
+{
+    return LOG_LOCAL_LEVEL >= level && esp_log_level_get(tag) >= level;
+}
+
+} // namespace logfmt
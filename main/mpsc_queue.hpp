@@ -0,0 +1,144 @@
+// mpsc_queue.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "cache_line.hpp"
+
+//------------------------------------------------------------
+// Bounded lock-free multi-producer / single-consumer queue
+//
+// Array of slots with per-slot sequence numbers (Vyukov).
+// Producers claim a slot with one CAS on the enqueue index and
+// publish it with a release store, so any task on either core
+// can post without a mutex. Only the owner task may drain.
+//------------------------------------------------------------
+namespace lockfree {
+
+// Clock that never ticks: drops the two timestamp reads per event
+// when latency tracking is not wanted
+struct untimed_clock {
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<untimed_clock>;
+    static constexpr bool is_steady = true;
+    static time_point now() noexcept { return time_point{}; }
+};
+
+struct QueueStats {
+    std::size_t depth;          // events waiting right now
+    std::uint32_t drops;        // pushes rejected because the queue was full
+    std::uint32_t max_latency_us; // worst push -> drain delay since last reset, saturating
+};
+
+template <typename T, std::size_t Capacity, typename Clock = std::chrono::steady_clock>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "events are copied into slots");
+
+public:
+    MpscQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any producer; returns false (and counts a drop) when full
+    bool try_push(const T& value)
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[pos & MASK];
+            const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                drops_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->pushed_at = Clock::now();
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner task only; hands up to max_batch events to fn in FIFO order
+    template <typename F>
+    std::size_t drain(F&& fn, std::size_t max_batch = Capacity)
+    {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        for (; n < max_batch; ++n, ++pos) {
+            Slot& slot = slots_[pos & MASK];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break;
+            }
+            const T value = slot.value;
+            const auto latency = Clock::now() - slot.pushed_at;
+            slot.sequence.store(pos + Capacity, std::memory_order_release);
+            dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+
+            // Saturates at ~71 min rather than wrapping
+            const auto latency_us = static_cast<std::uint32_t>(std::min<std::chrono::microseconds::rep>(
+                std::chrono::duration_cast<std::chrono::microseconds>(latency).count(),
+                std::numeric_limits<std::uint32_t>::max()));
+            if (latency_us > max_latency_us_.load(std::memory_order_relaxed)) {
+                max_latency_us_.store(latency_us, std::memory_order_relaxed);
+            }
+            fn(value);
+        }
+        return n;
+    }
+
+    [[nodiscard]] auto stats() const -> QueueStats
+    {
+        const std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return {
+            .depth = tail >= head ? tail - head : 0,
+            .drops = drops_.load(std::memory_order_relaxed),
+            .max_latency_us = max_latency_us_.load(std::memory_order_relaxed),
+        };
+    }
+
+    void reset_max_latency() { max_latency_us_.store(0, std::memory_order_relaxed); }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        typename Clock::time_point pushed_at;
+        T value;
+    };
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos_{0};
+    std::atomic<std::uint32_t> max_latency_us_{0}; // 32-bit: lock-free on Xtensa
+    alignas(cache_line_size) std::atomic<std::uint32_t> drops_{0};
+    std::array<Slot, Capacity> slots_;
+};
+
+} // namespace lockfree
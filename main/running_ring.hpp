@@ -0,0 +1,149 @@
+// running_ring.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+//------------------------------------------------------------
+// Fixed-capacity ring with an O(1) running sum and mean
+//
+// push() overwrites the oldest sample once full and updates the
+// sum by adding the new sample and subtracting the evicted one,
+// with Neumaier (improved Kahan) compensation so the rounding
+// error stays bounded however many samples stream through; the
+// cost per push is the same for 8 or 64K slots. Needs strict
+// IEEE arithmetic: -ffast-math folds the compensation away.
+// view() walks the samples oldest first; segments() gives the
+// same samples as at most two contiguous spans for kernels.
+//------------------------------------------------------------
+template <typename T, std::size_t Capacity>
+class RunningRing {
+    static_assert(Capacity > 0);
+
+public:
+    void push(T value)
+    {
+        if (size_ == Capacity) {
+            add(-slots_[head_]);
+        } else {
+            ++size_;
+        }
+        add(value);
+        slots_[head_] = value;
+        head_ = head_ + 1 == Capacity ? 0 : head_ + 1;
+    }
+
+    // Block push: samples that would be overwritten at once are skipped
+    void push(std::span<const T> values)
+    {
+        for (const T v : values.last(std::min(values.size(), Capacity))) {
+            push(v);
+        }
+    }
+
+    [[nodiscard]] T sum() const { return sum_ + compensation_; }
+
+    // Only meaningful when !empty()
+    [[nodiscard]] T mean() const { return sum() / static_cast<T>(size_); }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    // In place: a temporary would put Capacity samples on the stack
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+        sum_ = T{};
+        compensation_ = T{};
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    // Oldest run first; the second span is empty until the ring wraps
+    [[nodiscard]] std::array<std::span<const T>, 2> segments() const
+    {
+        const std::size_t start = size_ == Capacity ? head_ : 0;
+        const std::size_t first = std::min(size_, Capacity - start);
+        return { std::span<const T>{ slots_.data() + start, first },
+                 std::span<const T>{ slots_.data(), size_ - first } };
+    }
+
+    class View {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            T operator*() const { return (*ring_)[i_]; }
+            iterator& operator++()
+            {
+                ++i_;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator old = *this;
+                ++i_;
+                return old;
+            }
+            bool operator==(const iterator&) const = default;
+
+        private:
+            friend class View;
+            iterator(const RunningRing* ring, std::size_t i) : ring_{ ring }, i_{ i } {}
+
+            const RunningRing* ring_ = nullptr;
+            std::size_t i_ = 0;
+        };
+
+        [[nodiscard]] iterator begin() const { return { ring_, 0 }; }
+        [[nodiscard]] iterator end() const { return { ring_, ring_->size() }; }
+        [[nodiscard]] std::size_t size() const { return ring_->size(); }
+        [[nodiscard]] bool empty() const { return ring_->empty(); }
+        [[nodiscard]] T operator[](std::size_t i) const { return (*ring_)[i]; }
+        [[nodiscard]] T front() const { return (*ring_)[0]; }
+        [[nodiscard]] T back() const { return (*ring_)[ring_->size() - 1]; }
+
+    private:
+        friend class RunningRing;
+        explicit View(const RunningRing* ring) : ring_{ ring } {}
+
+        const RunningRing* ring_;
+    };
+
+    [[nodiscard]] View view() const { return View{ this }; }
+
+    // i = 0 is the oldest sample
+    [[nodiscard]] T operator[](std::size_t i) const
+    {
+        const std::size_t slot = (size_ == Capacity ? head_ : 0) + i;
+        return slots_[slot >= Capacity ? slot - Capacity : slot];
+    }
+
+private:
+    // Neumaier summation: the lost low-order part goes to compensation_
+    void add(T x)
+    {
+        const T t = sum_ + x;
+        if (std::abs(sum_) >= std::abs(x)) {
+            compensation_ += (sum_ - t) + x;
+        } else {
+            compensation_ += (x - t) + sum_;
+        }
+        sum_ = t;
+    }
+
+    std::array<T, Capacity> slots_{};
+    std::size_t head_ = 0; // next slot to write
+    std::size_t size_ = 0;
+    T sum_{};
+    T compensation_{};
+};
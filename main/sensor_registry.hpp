@@ -0,0 +1,171 @@
+// sensor_registry.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+
+//------------------------------------------------------------
+// Sensor concepts and a runtime sensor registry
+//
+// A variadic process_sensors(Sensors&&...) fixes the sensor set
+// at compile time and instantiates new code per combination.
+// SensorRegistry holds any mix of SensorType objects chosen at
+// run time instead: sensors are packed back to back into one
+// inline byte arena, each with a pointer to a static vtable
+// generated from the concepts (read_into is filled in only for
+// BlockSensorType), so nothing touches the heap, a 28-byte
+// sensor costs 28 bytes and one poll() loop serves every
+// configuration. The cost is an indirect call per sensor per
+// poll.
+//------------------------------------------------------------
+template <typename T>
+concept SensorType = requires(T t) {
+    { t.read() } -> std::convertible_to<float>;
+    { t.get_id() } -> std::convertible_to<int>;
+};
+
+// FIFO / DMA-fed sensors: hand over every pending sample in one call
+template <typename T>
+concept BlockSensorType = SensorType<T> && requires(T t, std::span<float> out) {
+    { t.read_into(out) } -> std::convertible_to<std::size_t>;
+};
+
+namespace sensors {
+
+struct VTable {
+    float (*read)(void* self);
+    int (*get_id)(const void* self);
+    std::size_t (*read_into)(void* self, std::span<float> out); // nullptr: read() only
+    void (*relocate)(void* to, void* from);                     // move-construct, destroy source
+    void (*destroy)(void* self);
+};
+
+// nullptr unless S hands over blocks
+template <SensorType S>
+constexpr auto read_into_for() -> std::size_t (*)(void*, std::span<float>)
+{
+    if constexpr (BlockSensorType<S>) {
+        return [](void* self, std::span<float> out) -> std::size_t { return static_cast<S*>(self)->read_into(out); };
+    } else {
+        return nullptr;
+    }
+}
+
+template <SensorType S>
+inline constexpr VTable vtable_for = {
+    [](void* self) -> float { return static_cast<S*>(self)->read(); },
+    [](const void* self) -> int { return static_cast<const S*>(self)->get_id(); },
+    read_into_for<S>(),
+    [](void* to, void* from) {
+        ::new (to) S{ std::move(*static_cast<S*>(from)) };
+        static_cast<S*>(from)->~S();
+    },
+    [](void* self) { static_cast<S*>(self)->~S(); },
+};
+
+// Up to Capacity sensors totalling at most Bytes; Block bounds the
+// samples one read_into() may hand over per poll
+template <std::size_t Capacity, std::size_t Bytes, std::size_t Block = 32>
+class SensorRegistry {
+public:
+    static constexpr std::size_t max_align = 32; // sim::NoiseSensor's lane arrays
+
+    SensorRegistry() = default;
+
+    SensorRegistry(SensorRegistry&& other) noexcept
+        : offsets_{ other.offsets_ }, vtables_{ other.vtables_ }, size_{ other.size_ }, used_{ other.used_ }
+    {
+        for (std::size_t i = 0; i < size_; ++i) {
+            vtables_[i]->relocate(at(i), other.at(i));
+        }
+        other.size_ = 0;
+        other.used_ = 0;
+    }
+
+    SensorRegistry(const SensorRegistry&) = delete;
+    SensorRegistry& operator=(const SensorRegistry&) = delete;
+    SensorRegistry& operator=(SensorRegistry&&) = delete;
+
+    ~SensorRegistry() { clear(); }
+
+    // Constructs S after the last sensor; nullptr when out of entries or bytes
+    template <SensorType S, typename... Args>
+    S* add(Args&&... args)
+    {
+        static_assert(sizeof(S) <= Bytes, "sensor does not fit the registry");
+        static_assert(alignof(S) <= max_align, "sensor is over-aligned for the registry");
+        const std::size_t offset = (used_ + alignof(S) - 1) & ~(alignof(S) - 1);
+        if (size_ == Capacity || offset + sizeof(S) > Bytes) {
+            return nullptr;
+        }
+        S* sensor = ::new (arena_ + offset) S{ std::forward<Args>(args)... };
+        offsets_[size_] = offset;
+        vtables_[size_++] = &vtable_for<S>;
+        used_ = offset + sizeof(S);
+        return sensor;
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < size_; ++i) {
+            vtables_[i]->destroy(at(i));
+        }
+        size_ = 0;
+        used_ = 0;
+    }
+
+    // Reads every sensor once. latest[i] gets sensor i's newest sample;
+    // on_samples(i, span) sees everything it produced (a whole FIFO block
+    // for block sensors, else the one reading). Returns sensors polled.
+    template <typename F>
+    std::size_t poll(std::span<float> latest, F&& on_samples)
+    {
+        const std::size_t n = std::min(size_, latest.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            void* const self = at(i);
+            const VTable& vt = *vtables_[i];
+            if (vt.read_into != nullptr) {
+                std::array<float, Block> block;
+                const std::size_t count = std::min(vt.read_into(self, block), Block);
+                if (count != 0) {
+                    latest[i] = block[count - 1];
+                    on_samples(i, std::span<const float>{ block.data(), count });
+                    continue;
+                }
+            }
+            latest[i] = vt.read(self); // plain sensor, or FIFO empty
+            on_samples(i, std::span<const float>{ &latest[i], 1 });
+        }
+        return n;
+    }
+
+    std::size_t poll(std::span<float> latest)
+    {
+        return poll(latest, [](std::size_t, std::span<const float>) {});
+    }
+
+    [[nodiscard]] int id(std::size_t i) const { return vtables_[i]->get_id(at(i)); }
+    [[nodiscard]] bool is_block(std::size_t i) const { return vtables_[i]->read_into != nullptr; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] std::size_t bytes_used() const { return used_; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    void* at(std::size_t i) { return arena_ + offsets_[i]; }
+    const void* at(std::size_t i) const { return arena_ + offsets_[i]; }
+
+    alignas(max_align) std::byte arena_[Bytes];
+    std::array<std::size_t, Capacity> offsets_{};
+    std::array<const VTable*, Capacity> vtables_{};
+    std::size_t size_ = 0;
+    std::size_t used_ = 0;
+};
+
+} // namespace sensors
@@ -0,0 +1,98 @@
+// seqlock.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "cache_line.hpp"
+
+//------------------------------------------------------------
+// Single-writer sequence lock for small snapshots
+//
+// The writer bumps the sequence to odd, copies the value in and
+// bumps it to even again; it never waits for readers. A reader
+// copies the value out and retries if the sequence was odd or
+// moved meanwhile, so it never sees a torn value and never
+// blocks the writer. The payload is stored as relaxed atomic
+// words, which keeps the concurrent copy free of data races
+// under the C++ memory model. For values of a few dozen bytes
+// published much less often than they are read.
+//------------------------------------------------------------
+namespace lockfree {
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots are copied word by word");
+
+public:
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T& value) { store(value); }
+
+    // Copies take a consistent snapshot of the source
+    SeqLock(const SeqLock& other) : SeqLock{ other.load() } {}
+    SeqLock& operator=(const SeqLock& other)
+    {
+        store(other.load());
+        return *this;
+    }
+
+    // Writer only
+    void store(const T& value)
+    {
+        std::array<std::uint32_t, WORDS> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any task; one attempt, false if a store was in progress
+    [[nodiscard]] bool try_load(T& out) const
+    {
+        const std::uint32_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+        std::array<std::uint32_t, WORDS> words;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, words.data(), sizeof(T));
+        return true;
+    }
+
+    // Any task; retries until it gets a consistent copy
+    [[nodiscard]] T load() const
+    {
+        T out;
+        while (!try_load(out)) {
+            std::this_thread::yield(); // the writer may be preempted mid-store
+        }
+        return out;
+    }
+
+    // Completed stores so far
+    [[nodiscard]] std::uint32_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+    alignas(cache_line_size) std::atomic<std::uint32_t> seq_{0};
+    std::array<std::atomic<std::uint32_t>, WORDS> words_{};
+};
+
+} // namespace lockfree
@@ -0,0 +1,240 @@
+// sim_clock.hpp
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if SIM_VIRTUAL_TIME
+#  include <condition_variable>
+#  include <functional>
+#  include <mutex>
+#  include <queue>
+#  include <vector>
+#endif
+
+//------------------------------------------------------------
+// Pacing for every periodic loop: sim::sleep_for / sim::now
+//
+// Default (target and normal host builds): plain steady_clock
+// and std::this_thread::sleep_for, sim::task(fn) is fn itself.
+//
+// SIM_VIRTUAL_TIME=1 (host only): a deterministic discrete-event
+// scheduler. Tasks wrapped with sim::task, plus the thread that
+// first uses the scheduler, run one at a time; a task gives up
+// the token only in sim::sleep_for, and the next one to run is
+// the earliest wake-up (ties in registration order). Virtual time
+// jumps straight to that wake-up, so hours of 2 s ticks pass in
+// milliseconds and the interleaving is identical run to run.
+// Tasks must not block on each other outside sleep_for.
+//------------------------------------------------------------
+#ifndef SIM_VIRTUAL_TIME
+#  define SIM_VIRTUAL_TIME 0
+#endif
+
+namespace sim {
+
+#if !SIM_VIRTUAL_TIME
+
+using clock = std::chrono::steady_clock;
+
+inline clock::time_point now() { return clock::now(); }
+
+template <typename Rep, typename Period>
+void sleep_for(std::chrono::duration<Rep, Period> d)
+{
+    std::this_thread::sleep_for(d);
+}
+
+// Wrap thread bodies: std::jthread t(sim::task([] { ... }));
+template <typename F>
+std::decay_t<F> task(F&& fn)
+{
+    return std::forward<F>(fn);
+}
+
+#else
+
+// Virtual time since the scheduler started
+struct clock {
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<clock>;
+    static constexpr bool is_steady = true;
+    static time_point now();
+};
+
+namespace detail {
+
+class Scheduler {
+public:
+    using id = std::size_t;
+
+    // Claims the token for a thread nobody registered (app_main)
+    id adopt()
+    {
+        std::unique_lock lock{ mutex_ };
+        const id self = next_id_++;
+        if (holder_ == INVALID) {
+            holder_ = self;
+            running_ = true;
+        } else {
+            enqueue(self, now_);
+            wait_for_token(lock, self);
+        }
+        return self;
+    }
+
+    // Called by the spawning task, so registration order is fixed
+    id reserve()
+    {
+        std::lock_guard lock{ mutex_ };
+        const id self = next_id_++;
+        enqueue(self, now_);
+        return self;
+    }
+
+    void start(id self)
+    {
+        std::unique_lock lock{ mutex_ };
+        wait_for_token(lock, self);
+    }
+
+    void sleep(id self, clock::duration d)
+    {
+        std::unique_lock lock{ mutex_ };
+        enqueue(self, now_ + std::max(d, clock::duration::zero()));
+        pass();
+        wait_for_token(lock, self);
+    }
+
+    void exit()
+    {
+        std::lock_guard lock{ mutex_ };
+        pass();
+    }
+
+    clock::duration now()
+    {
+        std::lock_guard lock{ mutex_ };
+        return now_;
+    }
+
+    // on_stop runs (under the scheduler lock) instead of advancing past limit
+    void stop_at(clock::duration limit, std::function<void()> on_stop)
+    {
+        std::lock_guard lock{ mutex_ };
+        stop_at_ = limit;
+        on_stop_ = std::move(on_stop);
+    }
+
+private:
+    struct Wake {
+        clock::duration at;
+        std::uint64_t seq;
+        id task;
+        bool operator>(const Wake& o) const { return at != o.at ? at > o.at : seq > o.seq; }
+    };
+
+    void enqueue(id task, clock::duration at) { wakes_.push({ at, seq_++, task }); }
+
+    void pass()
+    {
+        if (wakes_.empty()) {
+            holder_ = INVALID;
+            running_ = false;
+            return;
+        }
+        const Wake next = wakes_.top();
+        if (next.at > stop_at_ && on_stop_) {
+            on_stop_();
+        }
+        wakes_.pop();
+        now_ = std::max(now_, next.at);
+        holder_ = next.task;
+        running_ = true;
+        cv_.notify_all();
+    }
+
+    void wait_for_token(std::unique_lock<std::mutex>& lock, id self)
+    {
+        cv_.wait(lock, [this, self] { return running_ && holder_ == self; });
+    }
+
+    static constexpr id INVALID = static_cast<id>(-1);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Wake, std::vector<Wake>, std::greater<>> wakes_;
+    clock::duration now_{ 0 };
+    clock::duration stop_at_ = clock::duration::max();
+    std::function<void()> on_stop_;
+    std::uint64_t seq_ = 0;
+    id next_id_ = 0;
+    id holder_ = INVALID;
+    bool running_ = false;
+};
+
+// Never destroyed: detached tasks may still be waiting at exit
+inline Scheduler& scheduler()
+{
+    static Scheduler* s = new Scheduler;
+    return *s;
+}
+
+inline thread_local Scheduler::id self_id = static_cast<Scheduler::id>(-1);
+
+inline Scheduler::id self()
+{
+    if (self_id == static_cast<Scheduler::id>(-1)) {
+        self_id = scheduler().adopt();
+    }
+    return self_id;
+}
+
+} // namespace detail
+
+inline clock::time_point clock::now()
+{
+    return time_point{ detail::scheduler().now() };
+}
+
+inline clock::time_point now() { return clock::now(); }
+
+template <typename Rep, typename Period>
+void sleep_for(std::chrono::duration<Rep, Period> d)
+{
+    detail::scheduler().sleep(detail::self(), std::chrono::duration_cast<clock::duration>(d));
+}
+
+// Stops the simulation once virtual time would pass `limit`
+inline void stop_at(clock::duration limit, std::function<void()> on_stop)
+{
+    detail::scheduler().stop_at(limit, std::move(on_stop));
+}
+
+// Registers the task now, in the spawning thread; the returned
+// body waits for its turn, runs fn and hands the token on
+template <typename F>
+auto task(F&& fn)
+{
+    detail::self(); // the spawner must be a task too
+    const auto id = detail::scheduler().reserve();
+    return [id, fn = std::forward<F>(fn)]<typename... Args>(Args&&... args) mutable
+        requires std::invocable<std::decay_t<F>&, Args...>
+    {
+        detail::self_id = id;
+        detail::scheduler().start(id);
+        std::invoke(fn, std::forward<Args>(args)...);
+        detail::scheduler().exit();
+    };
+}
+
+#endif
+
+} // namespace sim
@@ -0,0 +1,175 @@
+// sim_sensors.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+//------------------------------------------------------------
+// Simulated sensors with per-instance random streams
+//
+// Each sensor owns its generator (xoshiro128++, 16 bytes of
+// state), so tasks on both cores never share or lock anything
+// and every seed gives the same stream run to run, unlike
+// rand(). read() draws one sample; NoiseSensor's generate(span)
+// fills a block from 8 independent lanes stepped together, a
+// loop the compiler vectorizes (SSE2/AVX2 on host) and that
+// still gives 8-way instruction-level parallelism on Xtensa and
+// RISC-V. ScalarNoiseSensor leaves the lanes out. Samples are
+// uniform in [base, base + range). FifoNoiseSensor adds the
+// block read_into(span) of FIFO/DMA-fed parts.
+//------------------------------------------------------------
+namespace sim {
+
+// SplitMix32: expands one seed into well-mixed state words
+constexpr std::uint32_t splitmix32(std::uint32_t& x)
+{
+    std::uint32_t z = (x += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+constexpr std::uint32_t rotl(std::uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+// Top 24 bits -> [0, 1); the int32 detour lets the conversion vectorize
+constexpr float to_unit(std::uint32_t x)
+{
+    return static_cast<float>(static_cast<std::int32_t>(x >> 8)) * 0x1p-24f;
+}
+
+class Xoshiro128pp {
+public:
+    explicit constexpr Xoshiro128pp(std::uint32_t seed)
+    {
+        for (auto& word : s_) {
+            word = splitmix32(seed);
+        }
+    }
+
+    constexpr std::uint32_t operator()()
+    {
+        const std::uint32_t result = rotl(s_[0] + s_[3], 7) + s_[0];
+        const std::uint32_t t = s_[1] << 9;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 11);
+        return result;
+    }
+
+    constexpr float uniform() { return to_unit((*this)()); }
+
+private:
+    std::array<std::uint32_t, 4> s_{};
+};
+
+// LANES xoshiro128++ generators in structure-of-arrays layout
+template <std::size_t LANES = 8>
+class LaneXoshiro {
+public:
+    explicit constexpr LaneXoshiro(std::uint32_t seed)
+    {
+        for (std::size_t l = 0; l < LANES; ++l) {
+            s0_[l] = splitmix32(seed);
+            s1_[l] = splitmix32(seed);
+            s2_[l] = splitmix32(seed);
+            s3_[l] = splitmix32(seed);
+        }
+    }
+
+    // out[i] = base + range * u, one step of every lane per LANES samples
+    void fill(std::span<float> out, float base, float range)
+    {
+        std::size_t i = 0;
+        for (; i + LANES <= out.size(); i += LANES) {
+            step(&out[i], base, range);
+        }
+        if (i < out.size()) {
+            std::array<float, LANES> tail;
+            step(tail.data(), base, range);
+            std::copy_n(tail.begin(), out.size() - i, out.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+
+private:
+    void step(float* out, float base, float range)
+    {
+        for (std::size_t l = 0; l < LANES; ++l) {
+            const std::uint32_t result = rotl(s0_[l] + s3_[l], 7) + s0_[l];
+            const std::uint32_t t = s1_[l] << 9;
+            s2_[l] ^= s0_[l];
+            s3_[l] ^= s1_[l];
+            s1_[l] ^= s2_[l];
+            s0_[l] ^= s3_[l];
+            s2_[l] ^= t;
+            s3_[l] = rotl(s3_[l], 11);
+            out[l] = base + range * to_unit(result);
+        }
+    }
+
+    alignas(32) std::array<std::uint32_t, LANES> s0_{};
+    alignas(32) std::array<std::uint32_t, LANES> s1_{};
+    alignas(32) std::array<std::uint32_t, LANES> s2_{};
+    alignas(32) std::array<std::uint32_t, LANES> s3_{};
+};
+
+// Uniform noise around a base value; satisfies SensorType. read() only,
+// 28 bytes: for sensors that never need the bulk path
+class ScalarNoiseSensor {
+public:
+    constexpr ScalarNoiseSensor(int id, float base, float range, std::uint32_t seed)
+        : id_{ id }, base_{ base }, range_{ range }, scalar_{ seed }
+    {}
+
+    float read() { return base_ + range_ * scalar_.uniform(); }
+    int get_id() const { return id_; }
+
+protected:
+    int id_;
+    float base_;
+    float range_;
+    Xoshiro128pp scalar_;
+};
+
+// ScalarNoiseSensor plus the 8-lane bulk generator (128 more bytes)
+class NoiseSensor : public ScalarNoiseSensor {
+public:
+    constexpr NoiseSensor(int id, float base, float range, std::uint32_t seed)
+        : ScalarNoiseSensor{ id, base, range, seed }, lanes_{ ~seed }
+    {}
+
+    // Bulk path for load tests; a separate stream from read()
+    void generate(std::span<float> out) { lanes_.fill(out, base_, range_); }
+
+private:
+    LaneXoshiro<> lanes_;
+};
+
+// NoiseSensor behind a hardware FIFO: each read_into() returns up to
+// `fifo_depth` samples, as a DMA- or FIFO-fed part would per poll
+class FifoNoiseSensor : public NoiseSensor {
+public:
+    constexpr FifoNoiseSensor(int id, float base, float range, std::uint32_t seed, std::size_t fifo_depth)
+        : NoiseSensor{ id, base, range, seed }, fifo_depth_{ fifo_depth }
+    {}
+
+    std::size_t read_into(std::span<float> out)
+    {
+        const std::span<float> block = out.first(std::min(out.size(), fifo_depth_));
+        generate(block);
+        return block.size();
+    }
+
+private:
+    std::size_t fifo_depth_;
+};
+
+} // namespace sim
@@ -0,0 +1,290 @@
+// simd_reduce.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if __has_include(<sdkconfig.h>)
+#  include <sdkconfig.h>
+#endif
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+//------------------------------------------------------------
+// Min / max / sum / fused min+max over spans of int and float
+//
+// Every backend is a struct with the same static kernels:
+//   scalar  portable reference, always available
+//   sse2    x86 hosts (__SSE2__)
+//   avx2    x86 hosts built with -mavx2 (__AVX2__)
+//   pie     ESP32-S3 PIE slot: provide simd_reduce_pie.hpp
+//           defining simd::backend::pie to enable it
+// simd::active is picked at compile time and the free functions
+// forward to it. Preconditions: min/max/minmax need a non-empty
+// span; float inputs must not contain NaN. Float sums are
+// reassociated by the vector backends, so they may differ from
+// the scalar sum in the last bits.
+//------------------------------------------------------------
+namespace simd {
+
+template <typename T>
+struct MinMax {
+    T min;
+    T max;
+};
+
+namespace backend {
+
+struct scalar {
+    template <typename T>
+    static T min(std::span<const T> s)
+    {
+        T m = s[0];
+        for (const T v : s) {
+            m = v < m ? v : m;
+        }
+        return m;
+    }
+
+    template <typename T>
+    static T max(std::span<const T> s)
+    {
+        T m = s[0];
+        for (const T v : s) {
+            m = v > m ? v : m;
+        }
+        return m;
+    }
+
+    template <typename T>
+    static MinMax<T> minmax(std::span<const T> s)
+    {
+        MinMax<T> r{ s[0], s[0] };
+        for (const T v : s) {
+            r.min = v < r.min ? v : r.min;
+            r.max = v > r.max ? v : r.max;
+        }
+        return r;
+    }
+
+    static std::int64_t sum(std::span<const int> s)
+    {
+        std::int64_t acc = 0;
+        for (const int v : s) {
+            acc += v;
+        }
+        return acc;
+    }
+
+    static float sum(std::span<const float> s)
+    {
+        float acc = 0.0f;
+        for (const float v : s) {
+            acc += v;
+        }
+        return acc;
+    }
+};
+
+#if defined(__SSE2__)
+struct sse2 {
+    static constexpr std::size_t LANES = 4;
+
+    // SSE2 has no 32-bit integer min/max; select through a compare mask
+    static __m128i min_epi32(__m128i a, __m128i b)
+    {
+        const __m128i gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+    }
+
+    static __m128i max_epi32(__m128i a, __m128i b)
+    {
+        const __m128i gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+    }
+
+    static __m128i load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static __m128 load(const float* p) { return _mm_loadu_ps(p); }
+    static __m128i vmin(__m128i a, __m128i b) { return min_epi32(a, b); }
+    static __m128i vmax(__m128i a, __m128i b) { return max_epi32(a, b); }
+    static __m128 vmin(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+    static __m128 vmax(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+    static void store(int* out, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v); }
+    static void store(float* out, __m128 v) { _mm_storeu_ps(out, v); }
+
+    template <typename T>
+    static MinMax<T> minmax(std::span<const T> s)
+    {
+        if (s.size() < LANES) {
+            return scalar::minmax(s);
+        }
+        auto lo = load(s.data());
+        auto hi = lo;
+        std::size_t i = LANES;
+        for (; i + LANES <= s.size(); i += LANES) {
+            const auto v = load(s.data() + i);
+            lo = vmin(lo, v);
+            hi = vmax(hi, v);
+        }
+        // Tail: reload the last full vector, overlapping is harmless for min/max
+        const auto tail = load(s.data() + s.size() - LANES);
+        lo = vmin(lo, tail);
+        hi = vmax(hi, tail);
+
+        T lanes_lo[LANES];
+        T lanes_hi[LANES];
+        store(lanes_lo, lo);
+        store(lanes_hi, hi);
+        return { scalar::min(std::span<const T>{ lanes_lo }), scalar::max(std::span<const T>{ lanes_hi }) };
+    }
+
+    template <typename T>
+    static T min(std::span<const T> s) { return minmax(s).min; }
+
+    template <typename T>
+    static T max(std::span<const T> s) { return minmax(s).max; }
+
+    static std::int64_t sum(std::span<const int> s)
+    {
+        // Sign-extend 4 x int32 into 2 + 2 x int64 lanes
+        __m128i acc = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + LANES <= s.size(); i += LANES) {
+            const __m128i v = load(s.data() + i);
+            const __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+        }
+        std::int64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        return lanes[0] + lanes[1] + scalar::sum(s.subspan(i));
+    }
+
+    static float sum(std::span<const float> s)
+    {
+        __m128 acc = _mm_setzero_ps();
+        std::size_t i = 0;
+        for (; i + LANES <= s.size(); i += LANES) {
+            acc = _mm_add_ps(acc, _mm_loadu_ps(s.data() + i));
+        }
+        float lanes[LANES];
+        _mm_storeu_ps(lanes, acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + scalar::sum(s.subspan(i));
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+struct avx2 {
+    static constexpr std::size_t LANES = 8;
+
+    static __m256i load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+    static __m256i vmin(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+    static __m256i vmax(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+    static __m256 vmin(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+    static __m256 vmax(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+    static void store(int* out, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v); }
+    static void store(float* out, __m256 v) { _mm256_storeu_ps(out, v); }
+
+    template <typename T>
+    static MinMax<T> minmax(std::span<const T> s)
+    {
+        if (s.size() < LANES) {
+            return sse2::minmax(s);
+        }
+        auto lo = load(s.data());
+        auto hi = lo;
+        std::size_t i = LANES;
+        for (; i + LANES <= s.size(); i += LANES) {
+            const auto v = load(s.data() + i);
+            lo = vmin(lo, v);
+            hi = vmax(hi, v);
+        }
+        const auto tail = load(s.data() + s.size() - LANES);
+        lo = vmin(lo, tail);
+        hi = vmax(hi, tail);
+
+        T lanes_lo[LANES];
+        T lanes_hi[LANES];
+        store(lanes_lo, lo);
+        store(lanes_hi, hi);
+        return { scalar::min(std::span<const T>{ lanes_lo }), scalar::max(std::span<const T>{ lanes_hi }) };
+    }
+
+    template <typename T>
+    static T min(std::span<const T> s) { return minmax(s).min; }
+
+    template <typename T>
+    static T max(std::span<const T> s) { return minmax(s).max; }
+
+    static std::int64_t sum(std::span<const int> s)
+    {
+        __m256i acc = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + LANES <= s.size(); i += LANES) {
+            const __m256i v = load(s.data() + i);
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        std::int64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + scalar::sum(s.subspan(i));
+    }
+
+    static float sum(std::span<const float> s)
+    {
+        __m256 acc = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + LANES <= s.size(); i += LANES) {
+            acc = _mm256_add_ps(acc, _mm256_loadu_ps(s.data() + i));
+        }
+        float lanes[LANES];
+        _mm256_storeu_ps(lanes, acc);
+        float total = 0.0f;
+        for (const float v : lanes) {
+            total += v;
+        }
+        return total + scalar::sum(s.subspan(i));
+    }
+};
+#endif
+
+} // namespace backend
+} // namespace simd
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && __has_include("simd_reduce_pie.hpp")
+#  include "simd_reduce_pie.hpp"
+#  define SIMD_REDUCE_HAS_PIE 1
+#endif
+
+namespace simd {
+
+#if defined(__AVX2__)
+using active = backend::avx2;
+#elif defined(__SSE2__)
+using active = backend::sse2;
+#elif defined(SIMD_REDUCE_HAS_PIE)
+using active = backend::pie;
+#else
+using active = backend::scalar;
+#endif
+
+template <typename T>
+[[nodiscard]] T min(std::span<const T> s) { return active::min(s); }
+
+template <typename T>
+[[nodiscard]] T max(std::span<const T> s) { return active::max(s); }
+
+template <typename T>
+[[nodiscard]] MinMax<T> minmax(std::span<const T> s) { return active::minmax(s); }
+
+[[nodiscard]] inline std::int64_t sum(std::span<const int> s) { return active::sum(s); }
+[[nodiscard]] inline float sum(std::span<const float> s) { return active::sum(s); }
+
+} // namespace simd
@@ -0,0 +1,98 @@
+// sliding_window.hpp
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------
+// Streaming min/max over the last Capacity samples
+//
+// Two monotonic deques (increasing for min, decreasing for max)
+// kept in fixed-size rings. Each sample is pushed and popped at
+// most once per deque, so push() is amortized O(1) and min()/max()
+// are O(1) regardless of the window size. No allocation.
+//------------------------------------------------------------
+template <typename T, std::size_t Capacity>
+class MinMaxWindow {
+    static_assert(Capacity > 0);
+
+public:
+    void push(T value)
+    {
+        // Sequence numbers wrap; they are only compared for equality.
+        // Expire first so a deque never holds more than Capacity slots.
+        const std::uint32_t seq = seq_++;
+        if (size_ < Capacity) {
+            ++size_;
+        } else {
+            min_.expire(seq - static_cast<std::uint32_t>(Capacity));
+            max_.expire(seq - static_cast<std::uint32_t>(Capacity));
+        }
+        min_.push(value, seq, [](T kept, T v) { return kept < v; });
+        max_.push(value, seq, [](T kept, T v) { return kept > v; });
+    }
+
+    // Only meaningful when !empty()
+    [[nodiscard]] T min() const { return min_.front(); }
+    [[nodiscard]] T max() const { return max_.front(); }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    // In place: a temporary would put 2 * Capacity slots on the stack
+    void clear()
+    {
+        min_.clear();
+        max_.clear();
+        seq_ = 0;
+        size_ = 0;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    // Ring of (value, sequence) with the extremum at the front
+    class MonotonicDeque {
+    public:
+        template <typename Keep>
+        void push(T value, std::uint32_t seq, Keep keep)
+        {
+            while (head_ != tail_ && !keep(slots_[(tail_ - 1) & MASK].value, value)) {
+                --tail_;
+            }
+            slots_[tail_++ & MASK] = { value, seq };
+        }
+
+        // Drops the front once it has slid out of the window
+        void expire(std::uint32_t oldest_gone)
+        {
+            if (head_ != tail_ && slots_[head_ & MASK].seq == oldest_gone) {
+                ++head_;
+            }
+        }
+
+        [[nodiscard]] T front() const { return slots_[head_ & MASK].value; }
+
+        void clear() { head_ = tail_ = 0; }
+
+    private:
+        static constexpr std::size_t SIZE = std::bit_ceil(Capacity);
+        static constexpr std::size_t MASK = SIZE - 1;
+
+        struct Slot {
+            T value;
+            std::uint32_t seq;
+        };
+
+        std::array<Slot, SIZE> slots_{};
+        std::uint32_t head_ = 0;
+        std::uint32_t tail_ = 0;
+    };
+
+    MonotonicDeque min_;
+    MonotonicDeque max_;
+    std::uint32_t seq_ = 0;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,131 @@
+// spsc_ring.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "cache_line.hpp"
+
+//------------------------------------------------------------
+// Bounded lock-free single-producer / single-consumer ring
+//
+// One task pushes, one task pops, each may run on its own core.
+// The producer owns tail_, the consumer owns head_, each on its
+// own cache line; a side publishes its index with a release
+// store and reads the other's with acquire. Each side also keeps
+// a private copy of the other's index and only reloads it when
+// the copy says full / empty, so steady streaming does not
+// bounce the shared line per element. Bulk push/pop move a run
+// of elements with at most two copies and one release.
+//------------------------------------------------------------
+namespace lockfree {
+
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "elements are copied into slots");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer only; false when full
+    bool try_push(const T& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == Capacity) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == Capacity) {
+                return false;
+            }
+        }
+        slots_[tail & MASK] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only; pushes as many as fit, returns how many
+    std::size_t push(std::span<const T> values)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t free = Capacity - (tail - head_cache_);
+        if (free < values.size()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            free = Capacity - (tail - head_cache_);
+        }
+        const std::size_t n = std::min(free, values.size());
+        if (n == 0) {
+            return 0;
+        }
+        const std::size_t start = tail & MASK;
+        const std::size_t first = std::min(n, Capacity - start);
+        std::copy_n(values.begin(), first, slots_.begin() + start);
+        std::copy_n(values.begin() + first, n - first, slots_.begin());
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer only; false when empty
+    bool try_pop(T& out)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return false;
+            }
+        }
+        out = slots_[head & MASK];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only; pops up to out.size(), returns how many
+    std::size_t pop(std::span<T> out)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t available = tail_cache_ - head;
+        if (available < out.size()) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            available = tail_cache_ - head;
+        }
+        const std::size_t n = std::min(available, out.size());
+        if (n == 0) {
+            return 0;
+        }
+        const std::size_t start = head & MASK;
+        const std::size_t first = std::min(n, Capacity - start);
+        std::copy_n(slots_.begin() + start, first, out.begin());
+        std::copy_n(slots_.begin(), n - first, out.begin() + first);
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Either side; exact only when the other side is idle
+    [[nodiscard]] std::size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    // Consumer line: its index and its view of the producer's
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    // Producer line
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+    alignas(cache_line_size) std::array<T, Capacity> slots_{};
+};
+
+} // namespace lockfree
@@ -0,0 +1,296 @@
+// timer_wheel.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "cycles.hpp"
+#include "sim_clock.hpp"
+
+//------------------------------------------------------------
+// Hierarchical timing wheel for one-shot and periodic timers
+//
+// Four levels of 64 slots, 6 bits of the expiry tick per level,
+// so delays up to 2^24 - 1 ticks (4.6 h at 1 ms) are exact.
+// Timers live in a fixed pool and are linked into their slot
+// with pool indices: schedule() and cancel() are O(1) and never
+// allocate. advance(now, fire) walks the ticks up to `now`,
+// moving a higher-level slot down one level whenever its block
+// begins, and calls fire(user) for every timer that expired,
+// re-arming the periodic ones.
+//
+// One wheel per task: schedule/cancel/advance from the owner
+// only. fire() may schedule and cancel.
+//------------------------------------------------------------
+namespace timing {
+
+using tick_t = std::uint64_t;
+
+struct TimerHandle {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool valid() const { return index != std::numeric_limits<std::uint32_t>::max(); }
+};
+
+struct WheelStats {
+    std::size_t active;          // timers currently scheduled
+    std::uint64_t fired;         // fire() calls since reset
+    tick_t max_lateness;         // worst (advance target - expiry), in ticks
+    double mean_lateness;        // average lateness per fired timer, in ticks
+    std::uint64_t advances;      // advance() calls since reset
+    std::uint32_t max_cost;      // most expensive advance(), in cycles::unit
+    double mean_cost_per_fire;   // advance() time per fired timer, in cycles::unit
+};
+
+template <std::size_t MaxTimers>
+class TimerWheel {
+    static_assert(MaxTimers > 0 && MaxTimers < std::numeric_limits<std::uint32_t>::max());
+
+public:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr std::size_t SLOTS = std::size_t{ 1 } << SLOT_BITS;
+    static constexpr tick_t MAX_DELAY = (tick_t{ 1 } << (LEVELS * SLOT_BITS)) - 1;
+
+    TimerWheel()
+    {
+        heads_.fill(NIL);
+        for (std::uint32_t i = 0; i < MaxTimers; ++i) {
+            timers_[i].next = i + 1 < MaxTimers ? i + 1 : NIL;
+        }
+        free_ = 0;
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Fires after `delay` ticks (at least 1), then every `period` ticks
+    // if period > 0. Returns an invalid handle when the pool is full.
+    TimerHandle schedule(tick_t delay, tick_t period, std::uint32_t user)
+    {
+        if (free_ == NIL) {
+            return {};
+        }
+        const std::uint32_t i = free_;
+        Timer& t = timers_[i];
+        free_ = t.next;
+
+        t.expires = now_ + std::clamp<tick_t>(delay, 1, MAX_DELAY);
+        t.period = std::min(period, MAX_DELAY);
+        t.user = user;
+        t.active = true;
+        link(i);
+        ++active_;
+        return { i, t.generation };
+    }
+
+    // False if the timer already fired (one-shot) or was cancelled
+    bool cancel(TimerHandle h)
+    {
+        if (!h.valid() || h.index >= MaxTimers) {
+            return false;
+        }
+        Timer& t = timers_[h.index];
+        if (!t.active || t.generation != h.generation) {
+            return false;
+        }
+        unlink(h.index);
+        release(h.index);
+        return true;
+    }
+
+    // Processes every tick up to and including `now`
+    template <typename Fire>
+    std::size_t advance(tick_t now, Fire&& fire)
+    {
+        const std::uint32_t start = cycles::now();
+        std::size_t fired = 0;
+        while (now_ < now) {
+            ++now_;
+            cascade_from(1);
+            fired += expire(heads_[now_ & MASK], now, fire);
+        }
+        const std::uint32_t cost = cycles::now() - start;
+        ++advances_;
+        total_cost_ += cost;
+        max_cost_ = std::max(max_cost_, cost);
+        return fired;
+    }
+
+    [[nodiscard]] tick_t now() const { return now_; }
+    [[nodiscard]] std::size_t active() const { return active_; }
+    static constexpr std::size_t capacity() { return MaxTimers; }
+
+    [[nodiscard]] WheelStats stats() const
+    {
+        return {
+            .active = active_,
+            .fired = fired_,
+            .max_lateness = max_lateness_,
+            .mean_lateness = fired_ ? static_cast<double>(total_lateness_) / static_cast<double>(fired_) : 0.0,
+            .advances = advances_,
+            .max_cost = max_cost_,
+            .mean_cost_per_fire = fired_ ? static_cast<double>(total_cost_) / static_cast<double>(fired_) : 0.0,
+        };
+    }
+
+    void reset_stats()
+    {
+        fired_ = 0;
+        max_lateness_ = 0;
+        total_lateness_ = 0;
+        advances_ = 0;
+        max_cost_ = 0;
+        total_cost_ = 0;
+    }
+
+private:
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+    static constexpr tick_t MASK = SLOTS - 1;
+
+    struct Timer {
+        tick_t expires = 0;
+        tick_t period = 0;
+        std::uint32_t user = 0;
+        std::uint32_t prev = NIL;
+        std::uint32_t next = NIL;
+        std::uint32_t slot = 0;       // index into heads_
+        std::uint32_t generation = 0;
+        bool active = false;
+    };
+
+    std::uint32_t slot_for(tick_t expires) const
+    {
+        const tick_t delta = expires - now_;
+        unsigned level = 0;
+        while (level + 1 < LEVELS && delta >= (tick_t{ 1 } << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        return static_cast<std::uint32_t>(level * SLOTS + ((expires >> (SLOT_BITS * level)) & MASK));
+    }
+
+    void link(std::uint32_t i)
+    {
+        Timer& t = timers_[i];
+        t.slot = slot_for(t.expires);
+        t.prev = NIL;
+        t.next = heads_[t.slot];
+        if (t.next != NIL) {
+            timers_[t.next].prev = i;
+        }
+        heads_[t.slot] = i;
+    }
+
+    void unlink(std::uint32_t i)
+    {
+        Timer& t = timers_[i];
+        if (t.prev != NIL) {
+            timers_[t.prev].next = t.next;
+        } else {
+            heads_[t.slot] = t.next;
+        }
+        if (t.next != NIL) {
+            timers_[t.next].prev = t.prev;
+        }
+    }
+
+    void release(std::uint32_t i)
+    {
+        Timer& t = timers_[i];
+        t.active = false;
+        ++t.generation;
+        t.next = free_;
+        free_ = i;
+        --active_;
+    }
+
+    // At the start of each level-L block, re-file that level's slot
+    // one level down; a slot index of 0 means the next level's block
+    // starts too.
+    void cascade_from(unsigned level)
+    {
+        for (; level < LEVELS; ++level) {
+            const tick_t below = now_ >> (SLOT_BITS * (level - 1));
+            if ((below & MASK) != 0) {
+                return;
+            }
+            const std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS + ((now_ >> (SLOT_BITS * level)) & MASK));
+            std::uint32_t i = heads_[slot];
+            heads_[slot] = NIL;
+            while (i != NIL) {
+                const std::uint32_t next = timers_[i].next;
+                link(i);
+                i = next;
+            }
+        }
+    }
+
+    template <typename Fire>
+    std::size_t expire(std::uint32_t& head, tick_t target, Fire& fire)
+    {
+        // Pop one at a time so fire() may cancel the rest of the slot;
+        // re-armed and newly scheduled timers never land back in it
+        std::size_t n = 0;
+        for (std::uint32_t i = head; i != NIL; i = head) {
+            Timer& t = timers_[i];
+            head = t.next;
+            if (head != NIL) {
+                timers_[head].prev = NIL;
+            }
+            const tick_t lateness = target - t.expires;
+            max_lateness_ = std::max(max_lateness_, lateness);
+            total_lateness_ += lateness;
+            ++fired_;
+            ++n;
+
+            const std::uint32_t user = t.user;
+            if (t.period > 0) {
+                // Late advance: drop the periods already missed, keep the phase
+                t.expires += ((target - t.expires) / t.period + 1) * t.period;
+                link(i);
+            } else {
+                release(i);
+            }
+            fire(user);
+        }
+        return n;
+    }
+
+    std::array<Timer, MaxTimers> timers_;
+    std::array<std::uint32_t, LEVELS * SLOTS> heads_;
+    std::uint32_t free_ = NIL;
+    std::size_t active_ = 0;
+    tick_t now_ = 0;
+
+    std::uint64_t fired_ = 0;
+    tick_t max_lateness_ = 0;
+    std::uint64_t total_lateness_ = 0;
+    std::uint64_t advances_ = 0;
+    std::uint32_t max_cost_ = 0;
+    std::uint64_t total_cost_ = 0;
+};
+
+//------------------------------------------------------------
+// Timer task body: one per core, each owning its wheel
+//
+// Sleeps to the next tick boundary and advances to the tick
+// sim::now() falls in, so oversleeping shows up as lateness
+// instead of drift. Schedule the initial timers before starting.
+//------------------------------------------------------------
+template <std::size_t N, typename Rep, typename Period, typename Fire>
+[[noreturn]] void drive(TimerWheel<N>& wheel, std::chrono::duration<Rep, Period> resolution, Fire fire)
+{
+    const auto start = sim::now();
+    while (true) {
+        const auto next = start + resolution * static_cast<Rep>(wheel.now() + 1);
+        sim::sleep_for(next - sim::now());
+        wheel.advance(static_cast<tick_t>((sim::now() - start) / resolution), fire);
+    }
+}
+
+} // namespace timing
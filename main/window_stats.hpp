@@ -0,0 +1,66 @@
+// window_stats.hpp
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "running_ring.hpp"
+#include "sliding_window.hpp"
+
+//------------------------------------------------------------
+// min / max / mean / count over the last Capacity samples
+//
+// Kept up to date on every push: the sum by RunningRing, the
+// extremes by MinMaxWindow's monotonic deques, both O(1)
+// (amortized) per sample whatever the window size. stats()
+// assembles them only when a push happened since the last
+// call; otherwise it returns the cached copy.
+//------------------------------------------------------------
+template <typename T>
+struct WindowStats {
+    T min;
+    T max;
+    T mean;
+    std::size_t count;
+};
+
+template <typename T, std::size_t Capacity>
+class StatsWindow {
+public:
+    void push(T value)
+    {
+        samples_.push(value);
+        extremes_.push(value);
+        dirty_ = true;
+    }
+
+    // Block push: samples that would be overwritten at once are skipped
+    void push(std::span<const T> values)
+    {
+        for (const T v : values.last(std::min(values.size(), Capacity))) {
+            push(v);
+        }
+    }
+
+    // All zero while empty
+    [[nodiscard]] const WindowStats<T>& stats() const
+    {
+        if (dirty_) {
+            cached_ = { extremes_.min(), extremes_.max(), samples_.mean(), samples_.size() };
+            dirty_ = false;
+        }
+        return cached_;
+    }
+
+    [[nodiscard]] const RunningRing<T, Capacity>& samples() const { return samples_; }
+    [[nodiscard]] std::size_t size() const { return samples_.size(); }
+    [[nodiscard]] bool empty() const { return samples_.empty(); }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    RunningRing<T, Capacity> samples_;
+    MinMaxWindow<T, Capacity> extremes_;
+    mutable WindowStats<T> cached_{};
+    mutable bool dirty_ = false;
+};
@@ -0,0 +1,357 @@
+// work_steal.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_pthread.h>
+
+#include "cache_line.hpp"
+
+//------------------------------------------------------------
+// Work-stealing parallel_for over pinned worker tasks
+//
+// Each worker owns a Chase-Lev deque (Lê et al., C11 version):
+// the owner pushes and pops at the bottom without contention,
+// idle workers steal from the top with one CAS. parallel_for
+// hands every worker a contiguous slice; a worker halves its
+// range onto its deque until it reaches `grain` and runs the
+// rest, so a worker that finishes early steals the biggest
+// pending halves from the others. Workers are std::jthreads
+// created through esp_pthread_cfg_t, pinned round-robin to the
+// cores, and sleep on a condition variable between jobs, or
+// after a bounded spin when there is nothing left to steal. With
+// zero workers parallel_for runs inline on the caller.
+//------------------------------------------------------------
+namespace lockfree {
+
+// Fixed-capacity Chase-Lev deque of small trivially copyable values.
+// Values sit in relaxed atomic words, as in SeqLock, so a thief may
+// read a slot the owner is writing without a data race; the CAS on
+// top_ decides whether that read counts.
+template <typename T, std::size_t Capacity>
+class ChaseLevDeque {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "values are copied word by word");
+
+public:
+    // Owner only; false when full
+    bool push(const T& value)
+    {
+        const std::uint32_t b = bottom_.load(std::memory_order_relaxed);
+        const std::uint32_t t = top_.load(std::memory_order_acquire);
+        if (distance(t, b) >= static_cast<std::int32_t>(Capacity)) {
+            return false;
+        }
+        write(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only; newest first
+    bool pop(T& out)
+    {
+        const std::uint32_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint32_t t = top_.load(std::memory_order_relaxed);
+        if (distance(t, b) < 0) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = read(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any other task; oldest first. False when empty or another thief won.
+    bool steal(T& out)
+    {
+        std::uint32_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::uint32_t b = bottom_.load(std::memory_order_acquire);
+        if (distance(t, b) <= 0) {
+            return false;
+        }
+        const T value = read(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return distance(top_.load(std::memory_order_acquire), bottom_.load(std::memory_order_acquire)) <= 0;
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    // The indices only ever grow and wrap at 2^32 on a long-lived
+    // deque; their signed difference stays exact while |b - t| < 2^31
+    static constexpr std::int32_t distance(std::uint32_t t, std::uint32_t b)
+    {
+        return static_cast<std::int32_t>(b - t);
+    }
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+    void write(std::uint32_t i, const T& value)
+    {
+        std::array<std::uint32_t, WORDS> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            slots_[static_cast<std::size_t>(i) & MASK][w].store(words[w], std::memory_order_relaxed);
+        }
+    }
+
+    T read(std::uint32_t i) const
+    {
+        std::array<std::uint32_t, WORDS> words;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            words[w] = slots_[static_cast<std::size_t>(i) & MASK][w].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    // 32-bit indices: 64-bit atomics are not lock-free on Xtensa / RISC-V
+    alignas(cache_line_size) std::atomic<std::uint32_t> top_{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> bottom_{0};
+    std::array<std::array<std::atomic<std::uint32_t>, WORDS>, Capacity> slots_{};
+};
+
+} // namespace lockfree
+
+namespace exec {
+
+struct ExecutorConfig {
+    std::size_t workers = portNUM_PROCESSORS;
+    int cores = portNUM_PROCESSORS; // worker i runs on core i % cores; 0 leaves them unpinned
+    std::size_t stack_size = 4096;
+    std::size_t prio = 5;
+    const char* name = "worker";
+};
+
+struct ExecutorStats {
+    std::uint64_t jobs;   // parallel_for calls
+    std::uint64_t ranges; // ranges run (after splitting)
+    std::uint64_t steals; // ranges taken from another worker
+};
+
+class Executor {
+public:
+    explicit Executor(const ExecutorConfig& config = {}) : workers_(config.workers)
+    {
+        esp_pthread_cfg_t saved;
+        const bool had_cfg = esp_pthread_get_cfg(&saved) == ESP_OK;
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            auto cfg = esp_pthread_get_default_config();
+            cfg.thread_name = config.name;
+            cfg.pin_to_core = config.cores > 0 ? static_cast<int>(i % static_cast<std::size_t>(config.cores)) : tskNO_AFFINITY;
+            cfg.stack_size = config.stack_size;
+            cfg.prio = config.prio;
+            esp_pthread_set_cfg(&cfg);
+            workers_[i].thread = std::jthread{ [this, i] { run_worker(i); } };
+        }
+        const auto restore = had_cfg ? saved : esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&restore);
+    }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    ~Executor()
+    {
+        {
+            std::lock_guard lock{ mutex_ };
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (Worker& w : workers_) {
+            if (w.thread.joinable()) {
+                w.thread.join();
+            }
+        }
+    }
+
+    // fn(i) for every i in [0, n), spread over the workers; returns when all
+    // are done. One job at a time: call from a single task, not from fn.
+    template <typename F>
+    void parallel_for(std::size_t n, std::size_t grain, F&& fn)
+    {
+        ++jobs_;
+        if (workers_.empty() || n <= grain) {
+            for (std::size_t i = 0; i < n; ++i) {
+                fn(i);
+            }
+            ranges_ += n > 0;
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        {
+            std::lock_guard lock{ mutex_ };
+            body_ = [](void* ctx, std::size_t i) { (*static_cast<Fn*>(ctx))(i); };
+            ctx_ = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+            grain_ = std::max<std::size_t>(grain, 1);
+            remaining_.store(n, std::memory_order_relaxed);
+            const std::size_t count = workers_.size();
+            for (std::size_t w = 0; w < count; ++w) {
+                workers_[w].seed = { static_cast<std::uint32_t>(n * w / count),
+                                     static_cast<std::uint32_t>(n * (w + 1) / count) };
+            }
+            epoch_.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake_.notify_all();
+
+        std::unique_lock lock{ mutex_ };
+        done_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0; });
+    }
+
+    [[nodiscard]] std::size_t workers() const { return workers_.size(); }
+
+    // Exact only between jobs
+    [[nodiscard]] ExecutorStats stats() const
+    {
+        ExecutorStats s{ jobs_, ranges_, 0 };
+        for (const Worker& w : workers_) {
+            s.ranges += w.ranges.load(std::memory_order_relaxed);
+            s.steals += w.steals.load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+private:
+    struct Range {
+        std::uint32_t begin;
+        std::uint32_t end;
+    };
+
+    // Halving a 2^32 range down to grain 1 needs 32 slots
+    static constexpr std::size_t DEQUE_CAPACITY = 64;
+    // Failed steal rounds before an idle worker sleeps until the next job
+    static constexpr std::size_t IDLE_SPINS = 64;
+
+    struct alignas(lockfree::cache_line_size) Worker {
+        lockfree::ChaseLevDeque<Range, DEQUE_CAPACITY> deque;
+        Range seed{};
+        // 32-bit like the deque indices; wrap after 2^32 ranges
+        std::atomic<std::uint32_t> ranges{ 0 };
+        std::atomic<std::uint32_t> steals{ 0 };
+        std::jthread thread;
+    };
+
+    void run_worker(std::size_t self)
+    {
+        Worker& me = workers_[self];
+        std::uint32_t seen = 0;
+        std::uint32_t victim = static_cast<std::uint32_t>(self);
+        while (true) {
+            Range seed;
+            {
+                std::unique_lock lock{ mutex_ };
+                wake_.wait(lock, [&] { return stop_ || epoch_.load(std::memory_order_relaxed) != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = epoch_.load(std::memory_order_relaxed);
+                seed = me.seed;
+            }
+
+            run_range(me, seed);
+            // Help until the job is done or the next one starts (its seed is
+            // waiting above). yield() only gives way to equal or higher
+            // priorities on FreeRTOS, so after IDLE_SPINS empty rounds go
+            // back to sleep: the owners finish what is left on their deques.
+            for (std::size_t idle = 0; idle < IDLE_SPINS
+                 && remaining_.load(std::memory_order_acquire) != 0
+                 && epoch_.load(std::memory_order_relaxed) == seen;) {
+                Range r;
+                if (me.deque.pop(r)) {
+                    run_range(me, r);
+                    continue;
+                }
+                bool stole = false;
+                for (std::size_t k = 1; k < workers_.size() && !stole; ++k) {
+                    victim = victim + 1 == workers_.size() ? 0 : victim + 1;
+                    if (victim != self && workers_[victim].deque.steal(r)) {
+                        me.steals.fetch_add(1, std::memory_order_relaxed);
+                        run_range(me, r);
+                        stole = true;
+                    }
+                }
+                if (stole) {
+                    idle = 0;
+                } else {
+                    ++idle;
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    void run_range(Worker& me, Range r)
+    {
+        if (r.begin == r.end) {
+            return;
+        }
+        // Keep the far half stealable, work on the near half
+        while (r.end - r.begin > grain_) {
+            const std::uint32_t mid = r.begin + (r.end - r.begin) / 2;
+            if (!me.deque.push({ mid, r.end })) {
+                break;
+            }
+            r.end = mid;
+        }
+        for (std::uint32_t i = r.begin; i < r.end; ++i) {
+            body_(ctx_, i);
+        }
+        me.ranges.fetch_add(1, std::memory_order_relaxed);
+        if (remaining_.fetch_sub(r.end - r.begin, std::memory_order_acq_rel) == r.end - r.begin) {
+            std::lock_guard lock{ mutex_ };
+            done_.notify_one();
+        }
+    }
+
+    std::vector<Worker> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    std::atomic<std::uint32_t> epoch_{ 0 }; // bumped under mutex_, polled by busy workers
+
+    // Current job; written under mutex_ before epoch_ moves
+    void (*body_)(void*, std::size_t) = nullptr;
+    void* ctx_ = nullptr;
+    std::size_t grain_ = 1;
+    alignas(lockfree::cache_line_size) std::atomic<std::size_t> remaining_{ 0 };
+
+    // Caller side
+    std::uint64_t jobs_ = 0;
+    std::uint64_t ranges_ = 0;
+};
+
+} // namespace exec